@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aoc
+{
+
+// Heap usage between AllocationTracker::start() and stop()
+struct AllocationStats {
+    uint64_t count{};
+    uint64_t bytes{};
+    uint64_t peakBytes{}; // highest live heap above the live heap at start()
+};
+
+// Reads the counters of the global operator new replacement compiled in with the AOC_TRACK_ALLOCATIONS CMake
+// option. Counts come from every thread, so measure one phase at a time.
+class AllocationTracker {
+public:
+    // False when the option is off, then stop() always returns zeros
+    static bool enabled();
+
+    void start();
+    AllocationStats stop() const;
+
+private:
+    uint64_t startCount{};
+    uint64_t startBytes{};
+    uint64_t startLive{};
+};
+
+} // namespace aoc
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <aoc/day.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace aoc
+{
+
+class ThreadPool;
+
+// Answers of one input of a batch. Part 2 is left empty when it is not solved.
+struct BatchResult {
+    std::string filename;
+    bool opened{};
+    size_t bytes{};
+    std::string answer1;
+    std::string answer2;
+    double parseSeconds{};
+    double part1Seconds{};
+    double part2Seconds{};
+
+    double seconds() const { return parseSeconds + part1Seconds + part2Seconds; }
+};
+
+// Files given directly are kept as is, directories are replaced by the regular files they contain in name order
+std::vector<std::string> expandInputs(const std::vector<std::string>& paths);
+
+// Reads all the files up front with a Prefetcher, then parses and solves every one on `pool`, part 2 as its own task.
+// Results are in the order of `filenames`.
+std::vector<BatchResult> solveBatch(const Day& day, const std::vector<std::string>& filenames, bool withPart2,
+                                    ThreadPool& pool);
+
+// Batch mode of a dayN binary: one line per input, then the aggregate throughput. Runs on ThreadPool::shared(), sized
+// by `threads` unless 0.
+// Part 2 is only solved when `test2`. Returns -1 when an input cannot be opened, 2 without part 2, 0 otherwise.
+int runBatch(const Day& day, bool test2, const std::vector<std::string>& paths, size_t threads);
+
+} // namespace aoc
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <aoc/alloc_tracker.hpp>
+#include <aoc/memory_tracker.hpp>
+#include <aoc/perf_counters.hpp>
+#include <fmt/format.h>
+#include <chrono>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc
+{
+
+struct BenchOptions {
+    int warmup{0};
+    int repetitions{1};
+    std::string jsonFilename;        // empty: no JSON output
+    std::string historyFilename;     // empty: no history, else the JSON records are appended keyed by commit and preset
+    std::string traceFilename;       // empty: no trace, else Chrome trace events of every span, see TraceSession
+    std::string profileFilename;     // empty: no profile, else sampled stacks folded for flame graphs, see Profiler
+    bool counters{false};            // hardware counters next to the timings
+    bool memory{false};              // peak resident set and page faults next to the timings
+    uint64_t memoryLimit{};          // bytes, the run stops once its resident set is above, see MemoryBudget. 0: none
+    bool sequential{false};          // parse after the samples and part 2 after part 1, instead of overlapping them
+    bool stream{false};              // both parts in one pass over the input read in chunks, see Day::stream
+    size_t chunkSize{size_t{1} << 20};
+    std::vector<std::string> inputs; // batch mode when not empty: files or directories to solve instead of the input
+    bool check{false};               // compare the parts with their references on the inputs too, see runCheck
+    size_t threads{};                // workers of batch mode and parallel parts, 0: hardware concurrency
+    // Answers of earlier runs, see ResultCache, empty: no cache. With verifyCache the day is solved even when they are
+    // cached, and compared with them.
+    std::string cacheDirectory{".aoc-cache"};
+    bool verifyCache{false};
+
+    // Parses `--warmup N`, `--reps N`, `--json FILE`, `--history FILE`, `--trace FILE`, `--profile FILE`, `--counters`,
+    // `--memory`, `--memory-limit MB`, `--sequential`, `--stream`, `--chunk BYTES`, `--threads N`, `--cache DIR`,
+    // `--no-cache`, `--verify-cache`, `--check` and input paths.
+    // Prints usage and returns nullopt on bad arguments.
+    static std::optional<BenchOptions> fromArgs(int argc, char* argv[]);
+
+    // True when the run is there for its timings rather than its answers: repeated, recorded, traced, profiled,
+    // counted or its memory measured
+    bool measures() const;
+
+    // Workers of ThreadPool::shared(), nullopt for its default. None when hardware counters are read outside batch
+    // mode and `countersAvailable`, see PerfCounters::available(): they only count the thread that opened them, so
+    // the parallel loops of a part run on that thread.
+    std::optional<size_t> sharedPoolSize(bool countersAvailable) const;
+};
+
+// Summary of the timed repetitions of one part, all times in seconds
+struct BenchStats {
+    size_t samples{};
+    double min{};
+    double median{};
+    double mean{};
+    double p95{};
+    double p99{};
+    double bytesPerSecond{};
+};
+
+// Nearest-rank percentiles of `samples`, throughput relative to `inputBytes`
+BenchStats computeStats(std::vector<double> samples, size_t inputBytes);
+
+class Bench {
+    struct Measurement {
+        BenchStats stats;
+        PerfCounters::Values counters; // average per timed run
+        AllocationStats allocations;   // average count and bytes per timed run, highest peak
+        MemoryStats memory;            // average faults per timed run, highest peak
+    };
+
+public:
+    // A measured phase not reported yet, so phases measured concurrently can still be reported in order
+    struct Timing {
+        std::string name;
+        std::string answer; // empty for a phase without one
+        Measurement measurement;
+    };
+
+    Bench(std::string_view dayName, std::string_view inputFilename, BenchOptions options);
+
+    // False when phases have to run one at a time on the thread that created the bench: with --sequential, and with
+    // hardware counters, allocation tracking or --memory, which count only that thread or the whole process
+    bool allowsConcurrency() const;
+
+    // Runs `fn` `warmup` times untimed then `repetitions` times timed, prints the answer of the last run together
+    // with the timing summary and appends a JSON record if requested
+    template <class Fn>
+    void run(std::string_view name, Fn&& fn) {
+        report(time(name, fn));
+    }
+
+    // Same as run() for a phase without an answer, such as parsing. Returns the result of the last run.
+    template <class Fn>
+    auto measure(std::string_view name, Fn&& fn) {
+        auto timed = timeResult(name, fn);
+        report(timed.second);
+        return std::move(timed.first);
+    }
+
+    // run() and measure() without the report
+    template <class Fn>
+    Timing time(std::string_view name, Fn&& fn) {
+        Timing res{std::string{name}, {}, {}};
+        res.answer = fmt::format("{}", repeat(fn, res.measurement));
+        return res;
+    }
+    template <class Fn>
+    auto timeResult(std::string_view name, Fn&& fn) {
+        Timing timing{std::string{name}, {}, {}};
+        auto res = repeat(fn, timing.measurement);
+        return std::pair{std::move(res), std::move(timing)};
+    }
+
+    void report(const Timing& timing);
+
+private:
+    template <class Fn>
+    std::invoke_result_t<Fn&> repeat(Fn& fn, Measurement& measurement) {
+        for (int i = 0; i < options.warmup; ++i) static_cast<void>(fn());
+        std::vector<double> samples;
+        samples.reserve(options.repetitions);
+        std::vector<PerfCounters::Values> counterSamples;
+        std::vector<AllocationStats> allocationSamples;
+        allocationSamples.reserve(options.repetitions);
+        std::vector<MemoryStats> memorySamples;
+        memorySamples.reserve(options.repetitions);
+        AllocationTracker allocations;
+        MemoryTracker memory;
+        std::optional<std::invoke_result_t<Fn&>> res;
+        for (int i = 0; i < options.repetitions; ++i) {
+            res.reset(); // outside the measured region
+            if (options.memory) memory.start();
+            if (counters) counters->start();
+            allocations.start();
+            const auto startTime = std::chrono::steady_clock::now();
+            res.emplace(fn());
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+            allocationSamples.push_back(allocations.stop());
+            if (counters) counterSamples.push_back(counters->stop());
+            if (options.memory) memorySamples.push_back(memory.stop());
+            samples.push_back(elapsed.count());
+        }
+        measurement.stats = computeStats(std::move(samples), inputBytes);
+        measurement.counters = averageCounters(counterSamples);
+        measurement.allocations = summarizeAllocations(allocationSamples);
+        measurement.memory = summarizeMemory(memorySamples);
+        return std::move(*res);
+    }
+
+    static PerfCounters::Values averageCounters(const std::vector<PerfCounters::Values>& samples);
+    static AllocationStats summarizeAllocations(const std::vector<AllocationStats>& samples);
+    static MemoryStats summarizeMemory(const std::vector<MemoryStats>& samples);
+
+    std::string_view dayName;
+    std::string_view inputFilename;
+    BenchOptions options;
+    size_t inputBytes{};
+    std::ofstream jsonFile;
+    std::ofstream historyFile;
+    std::optional<PerfCounters> counters;
+};
+
+} // namespace aoc
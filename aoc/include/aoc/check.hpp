@@ -0,0 +1,31 @@
+#pragma once
+
+#include <aoc/day.hpp>
+#include <string>
+#include <vector>
+
+namespace aoc
+{
+
+// One input solved by the reference of a part and by the day itself, parse included in both times
+struct CheckResult {
+    std::string input; // "sample N" or the filename
+    int part{};
+    bool opened{};
+    std::string answer;
+    std::string referenceAnswer;
+    double seconds{};
+    double referenceSeconds{};
+
+    bool agrees() const { return opened && answer == referenceAnswer; }
+};
+
+// Every reference of `day` against the day's own part, on the samples of that part, the real input and the files of
+// `paths` (directories are expanded like in batch mode). One run at a time so that the times compare.
+std::vector<CheckResult> checkReferences(const Day& day, const std::vector<std::string>& paths);
+
+// --check mode of a dayN binary: one line per input and part with both answers and the speedup over the reference.
+// Returns -1 when an answer differs or an input cannot be opened, and when the day has no reference.
+int runCheck(const Day& day, const std::vector<std::string>& paths);
+
+} // namespace aoc
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <aoc/input.hpp>
+#include <aoc/trace.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc
+{
+
+namespace detail
+{
+
+// Parsers and parts may take a std::pmr::memory_resource* as their last parameter, they are then given an arena that
+// is released in one go when the parsed input is dropped or when the part returns
+template <class Fn, class... Args>
+decltype(auto) invokeWithArena(const Fn& fn, std::pmr::memory_resource* arena, Args&&... args) {
+    if constexpr (std::is_invocable_v<const Fn&, Args..., std::pmr::memory_resource*>) {
+        return fn(std::forward<Args>(args)..., arena);
+    } else {
+        return fn(std::forward<Args>(args)...);
+    }
+}
+
+template <class Input>
+struct ArenaInput {
+    template <class ParseFn>
+    ArenaInput(const ParseFn& parse, std::string_view text)
+    : arena{std::max<size_t>(text.size(), 64)}, input{invokeWithArena(parse, &arena, text)} {}
+
+    std::pmr::monotonic_buffer_resource arena; // before the input, which it has to outlive
+    const Input input;
+};
+
+// Shared so both parts can run on different threads against the same input
+template <class ParseFn>
+auto parseShared(const ParseFn& parse, std::string_view text) {
+    using Input = std::remove_cvref_t<decltype(invokeWithArena(parse, nullptr, text))>;
+    const auto parsed = std::make_shared<const ArenaInput<Input>>(parse, text);
+    return std::shared_ptr<const Input>{parsed, &parsed->input};
+}
+
+// Every call gets its own scratch arena, so repeated and concurrent runs of a part never share one
+template <class SolveFn, class Input>
+std::string solveWithArena(const SolveFn& solve, const Input& input) {
+    std::pmr::monotonic_buffer_resource arena;
+    return fmt::format("{}", invokeWithArena(solve, &arena, input));
+}
+
+} // namespace detail
+
+// Both parts of a day bound to one parsed input, answers formatted as text
+struct Parts {
+    std::function<std::string()> part1;
+    std::function<std::string()> part2;
+};
+
+// Example from the puzzle text with the answer it gives for one part
+struct Sample {
+    int part{};
+    std::string_view input;
+    std::string answer;
+    // Parses `text` and binds the part to it, with the parameters of the example where they differ from the real
+    // input's (fewer steps, a smaller area, ...)
+    std::function<std::function<std::string()>(std::string_view text)> parse;
+    // Also verified by a static_assert, Day::test() skips it
+    bool checkedAtBuild{};
+};
+
+// Samples are raw strings opening on the line before their first line, the text starts after that newline
+constexpr std::string_view sampleText(std::string_view input) {
+    if (input.starts_with('\n')) input.remove_prefix(1);
+    return input;
+}
+
+// Sample solved by solve(parse(sampleText(input)))
+template <class Answer, class ParseFn, class SolveFn>
+Sample makeSample(int part, std::string_view input, const Answer& answer, ParseFn parse, SolveFn solve) {
+    input = sampleText(input);
+    return {part, input, fmt::format("{}", answer), [=](std::string_view text) {
+                const auto parsed = detail::parseShared(parse, text);
+                return std::function<std::string()>{[=] { return detail::solveWithArena(solve, *parsed); }};
+            }};
+}
+
+// For a sample whose answer a static_assert next to it already checks, e.g.
+//     static_assert(part1(parseInput(aoc::sampleText(sample1))) == 142);
+// so a dayN binary does no work for it at startup. test-dayN still solves it at run time.
+inline Sample checkedAtBuild(Sample sample) {
+    sample.checkedAtBuild = true;
+    return sample;
+}
+
+// Straightforward solution of one part kept next to the optimized one as its oracle, see withReference()
+struct Reference {
+    int part{};
+    // Parses `text` and solves the part, the answer formatted as text
+    std::function<std::string(std::string_view text)> solve;
+};
+
+// Type-erased solver of one day, so a single binary can run any of them
+struct Day {
+    std::string_view name;
+    std::string_view inputFilename;
+    std::vector<Sample> samples;
+    // The parsed input may keep views into `text`, which must outlive the returned parts
+    std::function<Parts(std::string_view text)> parse;
+    // False for a day whose part 2 is not a puzzle, then Parts::part2 is empty
+    bool hasPart2{true};
+    // Both answers in one pass over the file, read `chunkSize` bytes at a time, for a day whose parts fold over
+    // independent records: set by withStream(), empty for other days. Returns nullopt when the file cannot be read.
+    std::function<std::optional<std::pair<std::string, std::string>>(std::string_view filename, size_t chunkSize)>
+        stream{};
+    // Oracles of parts, compared with the day's own by `dayN --check`, see runCheck()
+    std::vector<Reference> references{};
+
+    // Solves every sample not checked at build time, printing expected and actual answers. A part passes when all its
+    // samples do, part 2 of a day without one never passes.
+    std::pair<bool, bool> test() const;
+};
+
+template <class ParseFn, class Part1Fn, class Part2Fn>
+Day makeDay(std::string_view name, std::string_view inputFilename, std::vector<Sample> samples, ParseFn parse,
+            Part1Fn part1, Part2Fn part2) {
+    return {name, inputFilename, std::move(samples), [=](std::string_view text) {
+                const auto input = [&] {
+                    const TraceSpan span{name, "parseInput"};
+                    return detail::parseShared(parse, text);
+                }();
+                return Parts{[=] {
+                                 const TraceSpan span{name, "part1"};
+                                 return detail::solveWithArena(part1, *input);
+                             },
+                             [=] {
+                                 const TraceSpan span{name, "part2"};
+                                 return detail::solveWithArena(part2, *input);
+                             }};
+            }};
+}
+
+// Day with only one part, like the last one of the calendar
+template <class ParseFn, class Part1Fn>
+Day makeDay(std::string_view name, std::string_view inputFilename, std::vector<Sample> samples, ParseFn parse,
+            Part1Fn part1) {
+    return {name, inputFilename, std::move(samples),
+            [=](std::string_view text) {
+                const auto input = [&] {
+                    const TraceSpan span{name, "parseInput"};
+                    return detail::parseShared(parse, text);
+                }();
+                return Parts{[=] {
+                                 const TraceSpan span{name, "part1"};
+                                 return detail::solveWithArena(part1, *input);
+                             },
+                             {}};
+            },
+            false};
+}
+
+// Gives `day` a streaming form: a default constructed `Fold` is given every record of the file with add(), one chunk
+// after the other, then asked for part1() and part2(). A record ends at any of `separators`, see forEachRecord(). The
+// fold only ever sees views of the current chunk, it has to copy whatever it keeps.
+template <class Fold>
+Day withStream(Day day, std::string_view separators = "\n") {
+    day.stream = [name = day.name, separators](std::string_view filename, size_t chunkSize)
+        -> std::optional<std::pair<std::string, std::string>> {
+        const TraceSpan span{name, "stream"};
+        ChunkReader reader{filename, separators, chunkSize};
+        if (!reader) return std::nullopt;
+        Fold fold;
+        for (std::string_view chunk; !(chunk = reader.next()).empty();)
+            forEachRecord(chunk, separators, [&](std::string_view record) { fold.add(record); });
+        return std::pair{fmt::format("{}", fold.part1()), fmt::format("{}", fold.part2())};
+    };
+    return day;
+}
+
+// Keeps solve(parse(text)) as the reference of `part`: the plain solution an optimized part replaced, which must keep
+// giving the same answers. Parser and solver may take an arena like the day's own.
+template <class ParseFn, class SolveFn>
+Day withReference(Day day, int part, ParseFn parse, SolveFn solve) {
+    day.references.push_back({part, [name = day.name, parse, solve](std::string_view text) {
+                                  const TraceSpan span{name, "reference"};
+                                  const auto parsed = detail::parseShared(parse, text);
+                                  return detail::solveWithArena(solve, *parsed);
+                              }});
+    return day;
+}
+
+// Standalone driver of a dayN binary: checks the samples, then benchmarks both parts on the real input, or solves the
+// inputs given on the command line with runBatch(), or solves the input with Day::stream on --stream, or compares the
+// parts with their references on --check.
+// Returns 1 or 2 when the sample of that part fails, -1 on bad arguments or a missing input.
+int runDay(const Day& day, int argc, char* argv[]);
+
+} // namespace aoc
@@ -0,0 +1,377 @@
+#pragma once
+
+#include <aoc/hash.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AOC_FLAT_HASH_SSE2
+#endif
+
+namespace aoc
+{
+
+// Occupancy of a FlatHashMap or FlatHashSet, for tuning hashes and load factors
+struct ProbeStats {
+    size_t size{};
+    size_t capacity{};
+    size_t tombstones{};
+    double loadFactor{};
+    double meanProbeLength{}; // groups of 16 slots looked at to find a key, 1 when it is in its home group
+    size_t maxProbeLength{};
+};
+
+namespace detail
+{
+
+// Control byte of every slot: empty, deleted, or the low 7 bits of the hash of its key
+inline constexpr int8_t kEmpty = -128;
+inline constexpr int8_t kDeleted = -2;
+inline constexpr size_t kGroupWidth = 16;
+
+// 16 consecutive control bytes, compared all at once. Bit i of a mask is set when byte i matches.
+class Group {
+public:
+    explicit Group(const int8_t* ctrl) {
+#ifdef AOC_FLAT_HASH_SSE2
+        bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+        std::memcpy(bytes.data(), ctrl, kGroupWidth);
+#endif
+    }
+
+#ifdef AOC_FLAT_HASH_SSE2
+    uint32_t match(int8_t h2) const { return movemask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), bytes)); }
+    uint32_t matchEmpty() const { return match(kEmpty); }
+    // kEmpty and kDeleted are the only control bytes below -1
+    uint32_t matchEmptyOrDeleted() const { return movemask(_mm_cmpgt_epi8(_mm_set1_epi8(-1), bytes)); }
+
+private:
+    static uint32_t movemask(__m128i v) { return static_cast<uint32_t>(_mm_movemask_epi8(v)); }
+    __m128i bytes;
+#else
+    uint32_t match(int8_t h2) const {
+        return maskOf([h2](int8_t ctrl) { return ctrl == h2; });
+    }
+    uint32_t matchEmpty() const { return match(kEmpty); }
+    uint32_t matchEmptyOrDeleted() const {
+        return maskOf([](int8_t ctrl) { return ctrl < -1; });
+    }
+
+private:
+    template <class Pred>
+    uint32_t maskOf(Pred pred) const {
+        uint32_t res{};
+        for (size_t i = 0; i < kGroupWidth; ++i) res |= static_cast<uint32_t>(pred(bytes[i])) << i;
+        return res;
+    }
+    std::array<int8_t, kGroupWidth> bytes;
+#endif
+};
+
+// Open addressing table of Swiss-table design: the control bytes of a group of 16 slots are probed with one SIMD
+// compare, and only the slots whose 7 hash bits match compare keys. Groups are visited in triangular order from the
+// home slot of a key. Erasing leaves a tombstone, reused by later inserts and dropped on rehash. The table grows at
+// 7/8 full. Insert and rehash invalidate iterators and references, unlike std::unordered_map.
+// `Value` is void for a set.
+template <class Key, class Value, class Hasher, class KeyEqual>
+class FlatHashTable {
+    static constexpr bool kIsSet = std::is_void_v<Value>;
+
+public:
+    using key_type = Key;
+    using value_type = std::conditional_t<kIsSet, Key, std::pair<const Key, Value>>;
+
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = FlatHashTable::value_type;
+        using reference = std::conditional_t<Const || kIsSet, const value_type&, value_type&>;
+        using pointer = std::conditional_t<Const || kIsSet, const value_type*, value_type*>;
+
+        Iterator() = default;
+        // Non-const to const
+        template <bool IsConst = Const>
+            requires IsConst
+        Iterator(const Iterator<false>& other) : table{other.table}, index{other.index} {}
+
+        reference operator*() const { return table->slots[index]; }
+        pointer operator->() const { return &table->slots[index]; }
+        Iterator& operator++() {
+            index = table->nextFull(index + 1);
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator res = *this;
+            ++*this;
+            return res;
+        }
+        bool operator==(const Iterator& other) const { return index == other.index; }
+
+    private:
+        friend class FlatHashTable;
+        friend class Iterator<!Const>;
+        using Table = std::conditional_t<Const, const FlatHashTable, FlatHashTable>;
+        Iterator(Table* table, size_t index) : table{table}, index{index} {}
+
+        Table* table{};
+        size_t index{};
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashTable() = default;
+    FlatHashTable(const FlatHashTable& other) { *this = other; }
+    FlatHashTable(FlatHashTable&& other) noexcept { swap(other); }
+    FlatHashTable& operator=(const FlatHashTable& other) {
+        if (this == &other) return *this;
+        destroy();
+        if (other.capacity == 0) return *this;
+        allocate(other.capacity);
+        std::copy_n(other.ctrl.get(), capacity + kGroupWidth, ctrl.get());
+        for (size_t i = 0; i < capacity; ++i)
+            if (isFull(ctrl[i])) std::construct_at(&slots[i], other.slots[i]);
+        elementCount = other.elementCount;
+        growthLeft = other.growthLeft;
+        return *this;
+    }
+    FlatHashTable& operator=(FlatHashTable&& other) noexcept {
+        FlatHashTable{std::move(other)}.swap(*this);
+        return *this;
+    }
+    ~FlatHashTable() { destroy(); }
+
+    void swap(FlatHashTable& other) noexcept {
+        std::swap(ctrl, other.ctrl);
+        std::swap(slots, other.slots);
+        std::swap(capacity, other.capacity);
+        std::swap(elementCount, other.elementCount);
+        std::swap(growthLeft, other.growthLeft);
+    }
+
+    iterator begin() { return {this, nextFull(0)}; }
+    iterator end() { return {this, capacity}; }
+    const_iterator begin() const { return {this, nextFull(0)}; }
+    const_iterator end() const { return {this, capacity}; }
+
+    size_t size() const { return elementCount; }
+    bool empty() const { return elementCount == 0; }
+
+    void clear() {
+        for (size_t i = 0; i < capacity; ++i)
+            if (isFull(ctrl[i])) std::destroy_at(&slots[i]);
+        if (capacity) std::fill_n(ctrl.get(), capacity + kGroupWidth, kEmpty);
+        elementCount = 0;
+        growthLeft = maxLoad(capacity);
+    }
+
+    // Room for `n` elements without a rehash
+    void reserve(size_t n) {
+        if (n <= elementCount + growthLeft) return;
+        size_t newCapacity = std::max(capacity, kGroupWidth);
+        while (maxLoad(newCapacity) < n) newCapacity *= 2;
+        rehash(newCapacity);
+    }
+
+    iterator find(const Key& key) { return {this, findIndex(key)}; }
+    const_iterator find(const Key& key) const { return {this, findIndex(key)}; }
+    bool contains(const Key& key) const { return findIndex(key) != capacity; }
+    size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    // Inserts Value(args...) unless `key` is present, like std::unordered_map::try_emplace
+    template <class... Args>
+        requires(!kIsSet)
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        const auto [index, inserted] = findOrPrepareInsert(key);
+        if (inserted) {
+            std::construct_at(&slots[index], std::piecewise_construct, std::forward_as_tuple(key),
+                              std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+        return {iterator{this, index}, inserted};
+    }
+
+    template <class V = Value>
+        requires(!kIsSet)
+    V& operator[](const Key& key) {
+        return try_emplace(key).first->second;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        const auto [index, inserted] = findOrPrepareInsert(keyOf(value));
+        if (inserted) std::construct_at(&slots[index], value);
+        return {iterator{this, index}, inserted};
+    }
+
+    size_t erase(const Key& key) {
+        const size_t index = findIndex(key);
+        if (index == capacity) return 0;
+        erase(iterator{this, index});
+        return 1;
+    }
+    void erase(const_iterator it) {
+        std::destroy_at(&slots[it.index]);
+        setCtrl(it.index, kDeleted);
+        --elementCount;
+    }
+
+    // Walks the probe sequence of every element, linear in the capacity
+    ProbeStats probeStats() const {
+        ProbeStats res;
+        res.size = elementCount;
+        res.capacity = capacity;
+        res.loadFactor = capacity ? static_cast<double>(elementCount) / static_cast<double>(capacity) : 0.0;
+        size_t totalProbeLength{};
+        for (size_t i = 0; i < capacity; ++i) {
+            if (ctrl[i] == kDeleted) ++res.tombstones;
+            if (!isFull(ctrl[i])) continue;
+            size_t probeLength = 1;
+            for (ProbeSequence seq{hasher(keyOf(slots[i])), mask()}; ((i - seq.offset) & mask()) >= kGroupWidth;
+                 seq.next())
+                ++probeLength;
+            totalProbeLength += probeLength;
+            res.maxProbeLength = std::max(res.maxProbeLength, probeLength);
+        }
+        if (elementCount)
+            res.meanProbeLength = static_cast<double>(totalProbeLength) / static_cast<double>(elementCount);
+        return res;
+    }
+
+private:
+    // Group starts visited for a hash: home, home + 16, home + 48, ... which reaches every slot of a power of two
+    // capacity
+    struct ProbeSequence {
+        ProbeSequence(size_t hash, size_t mask) : offset{(hash >> 7) & mask}, mask{mask} {}
+        void next() {
+            step += kGroupWidth;
+            offset = (offset + step) & mask;
+        }
+        size_t offset;
+        size_t mask;
+        size_t step{};
+    };
+
+    static bool isFull(int8_t ctrl) { return ctrl >= 0; }
+    static int8_t h2(size_t hash) { return static_cast<int8_t>(hash & 0x7f); }
+    static size_t maxLoad(size_t capacity) { return capacity - capacity / 8; }
+    static const Key& keyOf(const value_type& value) {
+        if constexpr (kIsSet) {
+            return value;
+        } else {
+            return value.first;
+        }
+    }
+
+    size_t mask() const { return capacity - 1; }
+
+    size_t nextFull(size_t index) const {
+        while (index < capacity && !isFull(ctrl[index])) ++index;
+        return index;
+    }
+
+    size_t findIndex(const Key& key) const {
+        if (capacity == 0) return 0;
+        const size_t hash = hasher(key);
+        for (ProbeSequence seq{hash, mask()};; seq.next()) {
+            const Group group{ctrl.get() + seq.offset};
+            for (uint32_t m = group.match(h2(hash)); m; m &= m - 1) {
+                const size_t index = (seq.offset + static_cast<size_t>(std::countr_zero(m))) & mask();
+                if (keyEqual(keyOf(slots[index]), key)) return index;
+            }
+            if (group.matchEmpty()) return capacity;
+        }
+    }
+
+    // First empty or deleted slot of the probe sequence, there is always one below the maximum load
+    size_t findFirstNonFull(size_t hash) const {
+        for (ProbeSequence seq{hash, mask()};; seq.next()) {
+            if (const uint32_t m = Group{ctrl.get() + seq.offset}.matchEmptyOrDeleted())
+                return (seq.offset + static_cast<size_t>(std::countr_zero(m))) & mask();
+        }
+    }
+
+    // Index of `key`, or of the slot reserved for it with its control byte already set
+    std::pair<size_t, bool> findOrPrepareInsert(const Key& key) {
+        if (const size_t index = findIndex(key); index != capacity) return {index, false};
+        if (growthLeft == 0) {
+            // Tombstones take up at least half of the load: cleaning them up is enough
+            rehash(capacity == 0 ? kGroupWidth : elementCount * 2 <= maxLoad(capacity) ? capacity : capacity * 2);
+        }
+        const size_t hash = hasher(key);
+        const size_t index = findFirstNonFull(hash);
+        if (ctrl[index] == kEmpty) --growthLeft;
+        setCtrl(index, h2(hash));
+        ++elementCount;
+        return {index, true};
+    }
+
+    // The first group is mirrored after the last slot, so a group load starting at any slot stays in bounds
+    void setCtrl(size_t index, int8_t value) {
+        ctrl[index] = value;
+        if (index < kGroupWidth) ctrl[capacity + index] = value;
+    }
+
+    void allocate(size_t newCapacity) {
+        capacity = newCapacity;
+        ctrl = std::make_unique<int8_t[]>(capacity + kGroupWidth);
+        std::fill_n(ctrl.get(), capacity + kGroupWidth, kEmpty);
+        slots = std::allocator<value_type>{}.allocate(capacity);
+        elementCount = 0;
+        growthLeft = maxLoad(capacity);
+    }
+
+    void destroy() {
+        if (capacity == 0) return;
+        for (size_t i = 0; i < capacity; ++i)
+            if (isFull(ctrl[i])) std::destroy_at(&slots[i]);
+        std::allocator<value_type>{}.deallocate(slots, capacity);
+        ctrl.reset();
+        slots = nullptr;
+        capacity = elementCount = growthLeft = 0;
+    }
+
+    void rehash(size_t newCapacity) {
+        FlatHashTable old;
+        swap(old);
+        allocate(newCapacity);
+        for (size_t i = 0; i < old.capacity; ++i) {
+            if (!isFull(old.ctrl[i])) continue;
+            const size_t hash = hasher(keyOf(old.slots[i]));
+            const size_t index = findFirstNonFull(hash);
+            setCtrl(index, h2(hash));
+            std::construct_at(&slots[index], std::move(old.slots[i]));
+        }
+        elementCount = old.elementCount;
+        growthLeft -= elementCount;
+    }
+
+    std::unique_ptr<int8_t[]> ctrl;
+    value_type* slots{};
+    size_t capacity{}; // 0 or a power of two of at least one group
+    size_t elementCount{};
+    size_t growthLeft{}; // empty slots that may still be filled before a rehash
+    [[no_unique_address]] Hasher hasher;
+    [[no_unique_address]] KeyEqual keyEqual;
+};
+
+} // namespace detail
+
+// Drop-in for std::unordered_map in hot loops, with the differences listed at FlatHashTable
+template <class Key, class Value, class Hasher = Hash<Key>, class KeyEqual = std::equal_to<Key>>
+using FlatHashMap = detail::FlatHashTable<Key, Value, Hasher, KeyEqual>;
+
+template <class Key, class Hasher = Hash<Key>, class KeyEqual = std::equal_to<Key>>
+using FlatHashSet = detail::FlatHashTable<Key, void, Hasher, KeyEqual>;
+
+} // namespace aoc
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <aoc/interner.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace aoc
+{
+
+template <class Weight>
+class GraphBuilder;
+
+// Directed graph in compressed sparse row form: vertices are the dense ids 0 ... size() - 1 and the out edges of a
+// vertex are one contiguous run of the edge array, in the order they were added. Built by GraphBuilder, immutable
+// afterwards. Undirected graphs store every edge in both directions.
+template <class Weight = int>
+class CsrGraph {
+public:
+    struct Edge {
+        uint32_t to;
+        Weight weight;
+    };
+
+    CsrGraph() = default;
+
+    size_t size() const { return offsets.size() - 1; }
+    size_t edgeCount() const { return edgeList.size(); }
+
+    std::span<const Edge> edges(uint32_t from) const {
+        return {edgeList.data() + offsets[from], edgeList.data() + offsets[from + 1]};
+    }
+
+    // Name the vertex was added with, empty for unnamed vertices
+    std::string_view name(uint32_t vertex) const { return vertex < names.size() ? names[vertex] : std::string_view{}; }
+    // Linear search, for looking up the few named vertices a puzzle starts from before walking the graph
+    std::optional<uint32_t> find(std::string_view vertexName) const {
+        const auto it = std::ranges::find(names, vertexName);
+        if (it == end(names)) return std::nullopt;
+        return static_cast<uint32_t>(it - begin(names));
+    }
+
+private:
+    friend class GraphBuilder<Weight>;
+
+    // First edge of every vertex, then the end of the edges: a single 0 without vertices
+    std::pmr::vector<uint32_t> offsets{0u};
+    std::pmr::vector<Edge> edgeList;
+    std::pmr::vector<std::string_view> names;
+};
+
+// Collects vertices and edges in any order, typically while parsing, and lays them out as a CsrGraph
+template <class Weight = int>
+class GraphBuilder {
+public:
+    // `vertexCount` unnamed vertices to start with
+    explicit GraphBuilder(size_t vertexCount = 0) : vertexCount{vertexCount} {}
+
+    // Id of the vertex called `name`, interned: named vertices are 0, 1, 2, ... in order of first use, don't mix them
+    // with vertices numbered by the caller. The graph keeps `name`, so it has to outlive the graph, like a view of the
+    // parsed text.
+    uint32_t vertex(std::string_view name) {
+        const uint32_t id = names.intern(name);
+        vertexCount = std::max<size_t>(vertexCount, id + size_t{1});
+        return id;
+    }
+
+    void addEdge(uint32_t from, uint32_t to, Weight weight = Weight{1}) {
+        vertexCount = std::max<size_t>(vertexCount, std::max(from, to) + size_t{1});
+        edges.push_back({from, {to, weight}});
+    }
+    void addUndirectedEdge(uint32_t u, uint32_t v, Weight weight = Weight{1}) {
+        addEdge(u, v, weight);
+        addEdge(v, u, weight);
+    }
+
+    size_t size() const { return vertexCount; }
+
+    // Counting sort of the edges by source, the edges of a vertex keep the order they were added in
+    CsrGraph<Weight> build(std::pmr::memory_resource* arena = std::pmr::get_default_resource()) const {
+        CsrGraph<Weight> res;
+        res.offsets = std::pmr::vector<uint32_t>(vertexCount + 1, 0, arena);
+        for (const auto& [from, edge] : edges) ++res.offsets[from + 1];
+        for (size_t v = 0; v < vertexCount; ++v) res.offsets[v + 1] += res.offsets[v];
+        res.edgeList = std::pmr::vector<typename CsrGraph<Weight>::Edge>(edges.size(), arena);
+        std::vector<uint32_t> next(res.offsets.begin(), res.offsets.end() - 1);
+        for (const auto& [from, edge] : edges) res.edgeList[next[from]++] = edge;
+        res.names = std::pmr::vector<std::string_view>(names.symbols().begin(), names.symbols().end(), arena);
+        return res;
+    }
+
+private:
+    size_t vertexCount;
+    Interner names;
+    std::vector<std::pair<uint32_t, typename CsrGraph<Weight>::Edge>> edges;
+};
+
+} // namespace aoc
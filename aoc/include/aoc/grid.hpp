@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc
+{
+
+// Row-major 2D grid in one contiguous buffer. Every side is surrounded by `padding` rows/columns of a sentinel value,
+// so (r, c) stays addressable for -padding <= r < rows() + padding, and stepping from an interior cell to its
+// neighbors needs no bounds checks when padding >= 1. Cells can be addressed either by (row, col) or by their flat
+// index(), and neighbors of an index are at index + offset with the offsets from offsets4()/offsets8(). Usable in
+// constant expressions as long as the grid does not outlive them.
+template <class T>
+class Grid {
+    static_assert(!std::is_same_v<T, bool>, "std::vector<bool> is not contiguous, use Grid<uint8_t>");
+
+public:
+    constexpr Grid() = default;
+    constexpr Grid(int rows, int cols, const T& value = T{}, int padding = 0, const T& sentinel = T{})
+    : nRows{rows}, nCols{cols}, nPadding{padding}, nStride{cols + 2 * padding},
+      cells(static_cast<size_t>(rows + 2 * padding) * static_cast<size_t>(cols + 2 * padding), sentinel) {
+        for (int r = 0; r < rows; ++r) std::ranges::fill(row(r), value);
+    }
+
+    // Same dimensions and padding as `other`, so flat indices of both grids address the same cells
+    template <class U>
+    static constexpr Grid shapedLike(const Grid<U>& other, const T& value = T{}, const T& sentinel = T{}) {
+        return Grid(other.rows(), other.cols(), value, other.padding(), sentinel);
+    }
+
+    // Character grid of equally long lines, throws std::invalid_argument when one is longer or shorter than the first
+    static constexpr Grid fromLines(const std::vector<std::string_view>& lines, int padding = 0, T sentinel = T{})
+        requires std::is_same_v<T, char>
+    {
+        Grid res(static_cast<int>(lines.size()), lines.empty() ? 0 : static_cast<int>(lines[0].size()), T{}, padding,
+                 sentinel);
+        for (int r = 0; r < res.rows(); ++r) {
+            if (std::ssize(lines[r]) != res.cols()) throw std::invalid_argument("Grid lines differ in length");
+            std::ranges::copy(lines[r], res.row(r).begin());
+        }
+        return res;
+    }
+
+    constexpr int rows() const { return nRows; }
+    constexpr int cols() const { return nCols; }
+    constexpr int padding() const { return nPadding; }
+    // Distance between vertically adjacent cells in the flat buffer
+    constexpr int stride() const { return nStride; }
+
+    constexpr size_t index(int r, int c) const {
+        return static_cast<size_t>(r + nPadding) * static_cast<size_t>(nStride) + static_cast<size_t>(c + nPadding);
+    }
+    constexpr std::pair<int, int> position(size_t i) const {
+        return {static_cast<int>(i / nStride) - nPadding, static_cast<int>(i % nStride) - nPadding};
+    }
+    constexpr bool contains(int r, int c) const { return 0 <= r && r < nRows && 0 <= c && c < nCols; }
+
+    constexpr T& operator()(int r, int c) { return cells[index(r, c)]; }
+    constexpr const T& operator()(int r, int c) const { return cells[index(r, c)]; }
+    constexpr T& operator[](size_t i) { return cells[i]; }
+    constexpr const T& operator[](size_t i) const { return cells[i]; }
+
+    // Interior cells of row r, without the padding
+    constexpr std::span<T> row(int r) { return {cells.data() + index(r, 0), static_cast<size_t>(nCols)}; }
+    constexpr std::span<const T> row(int r) const { return {cells.data() + index(r, 0), static_cast<size_t>(nCols)}; }
+    // The whole buffer including padding, e.g. to hash or compare a state
+    constexpr std::span<T> storage() { return cells; }
+    constexpr std::span<const T> storage() const { return cells; }
+
+    // Flat index offsets to the up, right, down and left neighbors
+    constexpr std::array<ptrdiff_t, 4> offsets4() const { return {-nStride, 1, nStride, -1}; }
+    // offsets4() followed by the four diagonals
+    constexpr std::array<ptrdiff_t, 8> offsets8() const {
+        return {-nStride, 1, nStride, -1, -nStride - 1, -nStride + 1, nStride - 1, nStride + 1};
+    }
+
+    constexpr bool operator==(const Grid&) const = default;
+
+private:
+    int nRows{};
+    int nCols{};
+    int nPadding{};
+    int nStride{};
+    std::vector<T> cells;
+};
+
+} // namespace aoc
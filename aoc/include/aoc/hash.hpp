@@ -0,0 +1,91 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace aoc
+{
+
+// splitmix64 finalizer: every input bit flips about half of the output bits, so the low bits a hash table indexes by
+// are as good as the high ones. std::hash of an integer is the identity on libstdc++ and libc++.
+constexpr uint64_t hashMix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111eb;
+    x ^= x >> 31;
+    return x;
+}
+
+// Eight bytes at a time, each word mixed into the state
+inline uint64_t hashBytes(std::string_view bytes) {
+    uint64_t h = hashMix(bytes.size() ^ 0x9e3779b97f4a7c15);
+    size_t i = 0;
+    for (; i + 8 <= bytes.size(); i += 8) {
+        uint64_t word{};
+        std::memcpy(&word, bytes.data() + i, 8);
+        h = hashMix(h ^ word);
+    }
+    if (i < bytes.size()) {
+        uint64_t word{};
+        std::memcpy(&word, bytes.data() + i, bytes.size() - i);
+        h = hashMix(h ^ word);
+    }
+    return h;
+}
+
+template <class T>
+struct Hash;
+
+template <class T>
+    requires std::integral<T> || std::is_enum_v<T>
+struct Hash<T> {
+    size_t operator()(T value) const { return static_cast<size_t>(hashMix(static_cast<uint64_t>(value))); }
+};
+
+template <>
+struct Hash<std::string_view> {
+    size_t operator()(std::string_view value) const { return static_cast<size_t>(hashBytes(value)); }
+};
+
+template <>
+struct Hash<std::string> : Hash<std::string_view> {};
+
+namespace detail
+{
+// Integers go in as they are, they get mixed into the state anyway
+template <class T>
+uint64_t hashWord(const T& value) {
+    if constexpr (std::integral<T> || std::is_enum_v<T>) {
+        return static_cast<uint64_t>(value);
+    } else {
+        return static_cast<uint64_t>(Hash<T>{}(value));
+    }
+}
+} // namespace detail
+
+// Every element mixed into the state in turn, so the order matters: hashValues(1, 2) != hashValues(2, 1)
+template <class... Ts>
+size_t hashValues(const Ts&... values) {
+    uint64_t h = 0x9e3779b97f4a7c15;
+    ((h = hashMix(h ^ detail::hashWord(values))), ...);
+    return static_cast<size_t>(h);
+}
+
+// std::pair, std::tuple and std::array
+template <class T>
+    requires requires { std::tuple_size<T>::value; }
+struct Hash<T> {
+    size_t operator()(const T& value) const {
+        return std::apply([](const auto&... elements) { return hashValues(elements...); }, value);
+    }
+};
+
+} // namespace aoc
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace aoc
+{
+
+// Commit the binary was built from, "-dirty" when the tree had uncommitted changes, and its compiler preset such as
+// "linux.gcc". Generated at build time by cmake/build_info.cmake.
+std::string_view buildCommit();
+std::string_view buildPreset();
+
+// Fields of a history record that runs are compared on. A record is the --json one of a phase with the commit, the
+// preset and the day in front, one per line.
+struct HistoryRecord {
+    std::string commit;
+    std::string preset;
+    std::string day;
+    std::string part;
+    double median{};
+};
+
+// nullopt for a line that is not a history record
+std::optional<HistoryRecord> parseHistoryRecord(std::string_view line);
+
+// Every record of `filename` in file order, nullopt when it cannot be read
+std::optional<std::vector<HistoryRecord>> readHistory(const std::string& filename);
+
+// Last two distinct commits measured with `preset`, {previous, latest} in file order
+std::optional<std::pair<std::string, std::string>> latestCommits(const std::vector<HistoryRecord>& records,
+                                                                  std::string_view preset);
+
+struct HistoryChange {
+    std::string day;
+    std::string part;
+    double baseline{};
+    double current{};
+
+    double ratio() const { return baseline > 0 ? current / baseline : 1.0; }
+};
+
+// Median of every phase measured with `preset` at both commits, in the order they were first recorded. A commit
+// measured more than once keeps its lowest median, the least disturbed run.
+std::vector<HistoryChange> compareHistory(const std::vector<HistoryRecord>& records, std::string_view preset,
+                                          std::string_view baseline, std::string_view current);
+
+} // namespace aoc
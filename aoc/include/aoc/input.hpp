@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aoc
+{
+
+// Read-only memory mapping of a whole file. Test with `if (!file)` like a std::ifstream.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(std::string_view filename);
+    ~MappedFile();
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    explicit operator bool() const { return isOpen; }
+    std::string_view text() const { return {data, size}; }
+
+private:
+    void close();
+
+    const char* data{};
+    size_t size{};
+    bool isOpen{};
+};
+
+// Reads a file `chunkSize` bytes at a time, every chunk cut after the last separator in it so that no record straddles
+// two chunks. Memory stays at about `chunkSize` whatever the size of the file, only a record longer than a chunk grows
+// the buffer to fit. Test with `if (!reader)` like a std::ifstream.
+class ChunkReader {
+public:
+    ChunkReader(std::string_view filename, std::string_view separators, size_t chunkSize);
+
+    explicit operator bool() const { return file != nullptr; }
+    // Next run of whole records, valid until the next call. Empty at the end of the file.
+    std::string_view next();
+
+private:
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file{nullptr, std::fclose};
+    std::string separators;
+    std::vector<char> buffer;
+    size_t handedOut{}; // end of the last chunk returned
+    size_t filled{};    // end of the bytes read
+};
+
+// Calls `fn` with a view of every record of `text`, the pieces between any of `separators`. A trailing '\r' is dropped
+// from each record and the empty record after a final separator is not reported, so with "\n" these are the lines
+// std::getline gives on a text-mode stream.
+template <class Fn>
+constexpr void forEachRecord(std::string_view text, std::string_view separators, Fn&& fn) {
+    while (!text.empty()) {
+        const size_t end = separators.size() == 1 ? text.find(separators[0]) : text.find_first_of(separators);
+        std::string_view record = text.substr(0, end);
+        if (record.ends_with('\r')) record.remove_suffix(1);
+        fn(record);
+        if (end == text.npos) break;
+        text.remove_prefix(end + 1);
+    }
+}
+
+// Views of every line of `text`, pointing into `text`, see forEachRecord()
+constexpr std::vector<std::string_view> splitLines(std::string_view text) {
+    std::vector<std::string_view> res;
+    forEachRecord(text, "\n", [&](std::string_view line) { res.push_back(line); });
+    return res;
+}
+
+} // namespace aoc
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <aoc/flat_hash_map.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace aoc
+{
+
+// Dense ids for names, 0, 1, 2, ... in order of first use, so that parsers turn the node names of a puzzle into ids
+// once and solvers index vectors with them instead of hashing strings in their inner loops. Keeps views of the names,
+// which have to outlive the interner, like views of the parsed text.
+class Interner {
+public:
+    Interner() = default;
+    // `symbols` take the first ids, for names a solver tests against, e.g. {"A", "R"} are 0 and 1
+    Interner(std::initializer_list<std::string_view> symbols) {
+        for (std::string_view symbol : symbols) intern(symbol);
+    }
+
+    // Id of `name`, the next free one on first use
+    uint32_t intern(std::string_view name) {
+        const auto [it, inserted] = ids.try_emplace(name, static_cast<uint32_t>(names.size()));
+        if (inserted) names.push_back(name);
+        return it->second;
+    }
+
+    std::optional<uint32_t> find(std::string_view name) const {
+        const auto it = ids.find(name);
+        if (it == ids.end()) return std::nullopt;
+        return it->second;
+    }
+
+    std::string_view name(uint32_t id) const { return names[id]; }
+    // Every name, indexed by id
+    const std::vector<std::string_view>& symbols() const { return names; }
+    size_t size() const { return names.size(); }
+
+private:
+    FlatHashMap<std::string_view, uint32_t> ids;
+    std::vector<std::string_view> names;
+};
+
+} // namespace aoc
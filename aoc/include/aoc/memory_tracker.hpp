@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace aoc
+{
+
+// Resident memory and page faults of the process between MemoryTracker::start() and stop()
+struct MemoryStats {
+    uint64_t peakRssBytes{}; // highest resident set above the resident set at start()
+    uint64_t minorFaults{};
+    uint64_t majorFaults{}; // faults that had to read from disk, such as the first touch of a mapped input
+};
+
+// Resident set from /proc/self/status and faults from getrusage. Both are of the whole process, so measure one phase
+// at a time. start() resets the peak the kernel keeps (VmHWM) so a phase peaking below an earlier one still reports
+// its own peak.
+class MemoryTracker {
+public:
+    // False when /proc is not there, then stop() always returns zeros
+    static bool available();
+
+    void start();
+    MemoryStats stop() const;
+
+private:
+    bool peakReset{};
+    uint64_t startRss{};
+    uint64_t startPeak{};
+    uint64_t startMinorFaults{};
+    uint64_t startMajorFaults{};
+};
+
+// Resident set of the process in bytes, 0 when unknown
+uint64_t residentBytes();
+
+// While alive, a thread checks the resident set every few milliseconds and ends the process with kExitCode and a
+// message once it is above `limitBytes`, rather than leaving a runaway day to the OOM killer. A fast-growing day can
+// overshoot by what it touches in that time. 0: no limit.
+class MemoryBudget {
+public:
+    static constexpr int kExitCode = 3;
+
+    explicit MemoryBudget(uint64_t limitBytes);
+
+private:
+    std::jthread watcher;
+};
+
+} // namespace aoc
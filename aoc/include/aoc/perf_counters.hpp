@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace aoc
+{
+
+// Hardware counters of the calling thread via Linux perf_event_open, user space only.
+// Events the kernel or the CPU refuses are left out; elsewhere nothing is available.
+class PerfCounters {
+public:
+    enum Event { kCycles, kInstructions, kL1dMisses, kLlcMisses, kBranchMisses, kEventCount };
+    using Values = std::array<std::optional<double>, kEventCount>; // nullopt: event not available
+
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const;
+    void start();
+    // Counts since the last start(), scaled up when the kernel had to multiplex the events
+    Values stop();
+
+private:
+    std::array<int, kEventCount> fds;
+};
+
+// "cycles 1.23G, instr 2.46G, IPC 2.00, ..." skipping missing events
+std::string formatCounters(const PerfCounters::Values& values);
+
+} // namespace aoc
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace aoc
+{
+
+// Reads a list of files into memory in the background, so that their I/O overlaps with whatever runs before they are
+// needed: the samples, and the days or inputs solved first. On Linux all the reads are queued on an io_uring at once.
+// Where io_uring is missing or refused, by an old kernel or the seccomp filter of a container, every file is read with
+// pread by a task of ThreadPool::shared() instead, or by the first thread asking for it.
+class Prefetcher {
+public:
+    explicit Prefetcher(std::vector<std::string> filenames);
+    ~Prefetcher();
+    Prefetcher(const Prefetcher&) = delete;
+    Prefetcher& operator=(const Prefetcher&) = delete;
+
+    size_t size() const;
+    // Content of the i-th file once read, nullopt when it cannot be read. Valid as long as the prefetcher.
+    std::optional<std::string_view> text(size_t i);
+    // "io_uring" or "pread"
+    std::string_view backend() const;
+
+    struct File;
+    struct Ring;
+
+private:
+    // Shared with the pread tasks, which may only run after the prefetcher is gone
+    std::shared_ptr<std::vector<File>> files;
+    std::unique_ptr<Ring> ring;
+    std::jthread ringThread; // last, stops and drains the ring before it is destroyed
+};
+
+} // namespace aoc
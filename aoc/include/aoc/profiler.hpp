@@ -0,0 +1,31 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace aoc
+{
+
+// Sampling profiler: while alive, a SIGPROF interval timer interrupts whichever thread is using the CPU `frequency`
+// times per second of CPU time and its call stack is recorded. On destruction the stacks are written to `filename`
+// folded, one "outer;...;inner count" line per distinct stack, as flamegraph.pl, inferno and speedscope read them.
+// Linux only, one profiler at a time.
+class Profiler {
+public:
+    // Empty filename: samples nothing
+    explicit Profiler(std::string filename, int frequency = 997);
+    ~Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    // False when the file cannot be written, profiling is not supported or no file was asked for
+    explicit operator bool() const { return buffer != nullptr; }
+
+    struct Buffer;
+
+private:
+    std::string filename;
+    std::unique_ptr<Buffer> buffer;
+};
+
+} // namespace aoc
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace aoc
+{
+
+// Answers of earlier runs of a day, one small text file per day, input content and solver build in `directory`, so
+// that a run on an unchanged input can print them without solving anything. Entries are never evicted, delete the
+// directory to clear it.
+class ResultCache {
+public:
+    struct Answers {
+        std::string part1;
+        std::optional<std::string> part2; // nullopt when the day has no part 2 or its samples failed
+
+        bool operator==(const Answers&) const = default;
+    };
+
+    // Keyed by a hash of `input` and buildId(), the input itself is not kept, only its hash
+    ResultCache(std::string_view directory, std::string_view dayName, std::string_view input);
+
+    // nullopt on a miss, or for an entry of another input or build that happens to share the hash
+    std::optional<Answers> load() const;
+    // Creates the directory if needed and replaces the entry at once, false when it cannot be written
+    bool store(const Answers& answers) const;
+
+    const std::string& path() const { return filename; }
+
+private:
+    std::string filename;
+    size_t inputHash; // of the whole input, kept in the entry so that a key collision is a miss
+};
+
+// Identifies the solver answers were computed by: a hash of the running executable where it can be read, else the
+// commit and preset it was built from
+std::string_view buildId();
+
+} // namespace aoc
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace aoc
+{
+
+// std::from_chars for integers, usable in constant expressions before the standard library's own is constexpr
+// (C++23). Same results, including a value left untouched on failure.
+template <std::integral T>
+constexpr std::from_chars_result fromChars(const char* first, const char* last, T& value, int base = 10) {
+    if !consteval {
+        return std::from_chars(first, last, value, base);
+    }
+    using U = std::make_unsigned_t<T>;
+    const char* p = first;
+    const bool negative = std::is_signed_v<T> && p != last && *p == '-';
+    if (negative) ++p;
+    const U limit = static_cast<U>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+    const char* digits = p;
+    U res{};
+    bool overflow = false;
+    for (; p != last; ++p) {
+        const char ch = *p;
+        const int digit = '0' <= ch && ch <= '9'   ? ch - '0'
+                          : 'a' <= ch && ch <= 'z' ? ch - 'a' + 10
+                          : 'A' <= ch && ch <= 'Z' ? ch - 'A' + 10
+                                                   : base;
+        if (digit >= base) break;
+        const auto d = static_cast<U>(digit);
+        const auto b = static_cast<U>(base);
+        overflow = overflow || res > (limit - d) / b;
+        if (!overflow) res = static_cast<U>(res * b + d);
+    }
+    if (p == digits) return {first, std::errc::invalid_argument};
+    if (overflow) return {p, std::errc::result_out_of_range};
+    value = static_cast<T>(negative ? static_cast<U>(U{} - res) : res);
+    return {p, std::errc{}};
+}
+
+// Drop-in for `std::istream >>` on puzzle text: whitespace separated tokens and integers read straight out of a
+// string_view with std::from_chars, without locales, copies or allocations. Like a stream it turns false after the
+// first failed read and ignores every read after that. Everything is constexpr, so parsers built on it can run in a
+// static_assert.
+class Scanner {
+public:
+    constexpr explicit Scanner(std::string_view text) : text{text} {}
+
+    constexpr explicit operator bool() const { return !failed; }
+    // Everything not consumed yet
+    constexpr std::string_view rest() const { return text.substr(pos); }
+
+    constexpr void skipSpace() {
+        while (pos < text.size() && isSpace(text[pos])) ++pos;
+    }
+    // Consumes `literal` after whitespace, fails if something else comes next
+    constexpr Scanner& expect(std::string_view literal) {
+        skipSpace();
+        if (!failed && rest().starts_with(literal)) {
+            pos += literal.size();
+        } else {
+            failed = true;
+        }
+        return *this;
+    }
+
+    // Next run of non-whitespace characters, pointing into the text
+    constexpr Scanner& operator>>(std::string_view& token) {
+        skipSpace();
+        if (failed || pos == text.size()) {
+            failed = true;
+            return *this;
+        }
+        const size_t start = pos;
+        while (pos < text.size() && !isSpace(text[pos])) ++pos;
+        token = text.substr(start, pos - start);
+        return *this;
+    }
+    // Next non-whitespace character
+    constexpr Scanner& operator>>(char& ch) {
+        skipSpace();
+        if (failed || pos == text.size()) {
+            failed = true;
+            return *this;
+        }
+        ch = text[pos++];
+        return *this;
+    }
+    template <std::integral T>
+    constexpr Scanner& operator>>(T& value) {
+        return readInt(value, 10);
+    }
+    // Like std::num_get, value is zeroed when the read fails
+    template <std::integral T>
+    constexpr Scanner& readInt(T& value, int base) {
+        skipSpace();
+        const auto [end, ec] = fromChars(text.data() + pos, text.data() + text.size(), value, base);
+        if (failed || ec != std::errc{}) {
+            value = T{};
+            failed = true;
+        } else {
+            pos = static_cast<size_t>(end - text.data());
+        }
+        return *this;
+    }
+
+private:
+    static constexpr bool isSpace(char ch) { return ch == ' ' || ('\t' <= ch && ch <= '\r'); }
+
+    std::string_view text;
+    size_t pos{};
+    bool failed{};
+};
+
+// Leading integer of `sv`, 0 when it does not start with one. Replaces std::stoi/std::stoll on views.
+template <std::integral T = int>
+constexpr T parseInt(std::string_view sv, int base = 10) {
+    T value{};
+    fromChars(sv.data(), sv.data() + sv.size(), value, base);
+    return value;
+}
+
+} // namespace aoc
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace aoc
+{
+
+// Fixed set of workers, each with its own task deque: a worker runs its newest task first and, out of work, steals
+// the oldest task of another worker. Tasks may submit more tasks, they go to the deque of their worker. A pool without
+// workers runs every task and loop on the thread submitting it.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threadCount = defaultSize());
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+    // Blocks until the queue is empty and no task is running
+    void wait();
+
+    size_t size() const { return workers.size(); }
+    // Index of the calling thread among the workers, size() for any other thread
+    size_t workerIndex() const;
+
+    // Calls fn(i) for every i in [0, count), split into chunks taken by the workers and the calling thread, and
+    // returns once all are done. Can be called from a task: the waiting worker runs other tasks meanwhile.
+    template <class Fn>
+    void parallelFor(size_t count, Fn&& fn) {
+        forEachChunk(count, chunkCount(count), [&](size_t, size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) fn(i);
+        });
+    }
+
+    // combine(init, fn(0), fn(1), ..., fn(count - 1)) with `combine` associative, e.g. a sum or a max. Partial results
+    // are combined in index order, so the result does not depend on the scheduling.
+    template <class T, class Fn, class Combine>
+    T parallelReduce(size_t count, T init, Fn&& fn, Combine&& combine) {
+        const size_t chunks = chunkCount(count);
+        std::vector<std::optional<T>> partials(chunks);
+        forEachChunk(count, chunks, [&](size_t chunk, size_t first, size_t last) {
+            std::optional<T>& partial = partials[chunk];
+            for (size_t i = first; i < last; ++i) partial = partial ? combine(std::move(*partial), fn(i)) : T(fn(i));
+        });
+        for (auto& partial : partials)
+            if (partial) init = combine(std::move(init), std::move(*partial));
+        return init;
+    }
+
+    // Hardware concurrency, 1 when unknown
+    static size_t defaultSize() { return std::max<size_t>(std::thread::hardware_concurrency(), 1); }
+    // Pool the parallel parts of every day run on, created on first use
+    static ThreadPool& shared();
+    // Workers of the shared pool, defaultSize() unless set. Only has an effect before its first use.
+    static void setSharedSize(size_t threadCount);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    // A few chunks per thread, so that stealing evens out items of uneven cost
+    size_t chunkCount(size_t count) const { return std::min(count, workers.empty() ? 1 : (size() + 1) * 4); }
+    void forEachChunk(size_t count, size_t chunks, const std::function<void(size_t, size_t, size_t)>& chunkFn);
+    bool runPendingTask(size_t index);
+    void workerLoop(size_t index, std::stop_token stopToken);
+
+    std::mutex mutex;
+    std::condition_variable_any hasWork;
+    std::condition_variable idle;
+    size_t queued{};
+    size_t running{};
+    std::vector<std::unique_ptr<Queue>> queues; // one per worker, then one for tasks submitted by other threads
+    std::vector<std::jthread> workers;          // last, so workers stop before the queues are destroyed
+};
+
+// One T per worker of a pool, and one for the thread calling parallelFor(): scratch buffers a loop reuses from item to
+// item instead of allocating them for every item. An item must not hold on to it across a nested parallelFor(), its
+// worker may run another item of the same loop in the meantime.
+template <class T>
+class PerWorker {
+public:
+    explicit PerWorker(const ThreadPool& pool = ThreadPool::shared()) : pool{pool}, slots(pool.size() + 1) {}
+
+    T& local() { return slots[pool.workerIndex()].value; }
+
+private:
+    struct alignas(64) Slot {
+        T value{};
+    };
+
+    const ThreadPool& pool;
+    std::vector<Slot> slots;
+};
+
+template <class Fn>
+void parallelFor(size_t count, Fn&& fn) {
+    ThreadPool::shared().parallelFor(count, std::forward<Fn>(fn));
+}
+
+template <class T, class Fn, class Combine>
+T parallelReduce(size_t count, T init, Fn&& fn, Combine&& combine) {
+    return ThreadPool::shared().parallelReduce(count, std::move(init), std::forward<Fn>(fn),
+                                               std::forward<Combine>(combine));
+}
+
+} // namespace aoc
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace aoc
+{
+
+// Records every TraceSpan of every thread while alive and writes them to `filename` as Chrome trace events on
+// destruction, to open in ui.perfetto.dev or chrome://tracing. One session at a time.
+class TraceSession {
+public:
+    // Empty filename: records nothing
+    explicit TraceSession(std::string filename);
+    ~TraceSession();
+    TraceSession(const TraceSession&) = delete;
+    TraceSession& operator=(const TraceSession&) = delete;
+
+    // False when the file cannot be written or no file was asked for
+    explicit operator bool() const { return recording; }
+
+    static bool active();
+
+private:
+    std::string filename;
+    bool recording{};
+};
+
+// Span from construction to destruction on the calling thread, shown on the row of that thread. `category` and `name`
+// must outlive the session, such as literals or Day::name. Outside a session it only checks TraceSession::active().
+class TraceSpan {
+public:
+    TraceSpan(std::string_view category, std::string_view name);
+    TraceSpan(std::string_view category, std::string_view name, std::string_view argName, int64_t argValue);
+    TraceSpan(std::string_view category, std::string_view name, std::string_view argName, std::string_view argValue);
+    ~TraceSpan();
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    std::string_view category;
+    std::string_view name;
+    std::string args; // JSON members of "args"
+    std::chrono::steady_clock::time_point startTime;
+    bool active;
+};
+
+} // namespace aoc
@@ -0,0 +1,142 @@
+#include <aoc/alloc_tracker.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace aoc
+{
+
+namespace
+{
+
+std::atomic<uint64_t> allocationCount{};
+std::atomic<uint64_t> allocatedBytes{};
+std::atomic<uint64_t> liveBytes{};
+std::atomic<uint64_t> peakLiveBytes{};
+
+#ifdef AOC_TRACK_ALLOCATIONS
+// Stored right before every block so delete knows the size without relying on sized deallocation
+struct Header {
+    void* base;
+    size_t size;
+};
+
+void* allocate(size_t size, size_t alignment) noexcept {
+    alignment = alignment < alignof(std::max_align_t) ? alignof(std::max_align_t) : alignment;
+    void* base = std::malloc(size + sizeof(Header) + alignment);
+    if (!base) return nullptr;
+    const auto user = (reinterpret_cast<uintptr_t>(base) + sizeof(Header) + alignment - 1) & ~(alignment - 1);
+    auto* header = reinterpret_cast<Header*>(user) - 1;
+    *header = {base, size};
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    const uint64_t live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    for (uint64_t peak = peakLiveBytes.load(std::memory_order_relaxed);
+         live > peak && !peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed);) {}
+    return reinterpret_cast<void*>(user);
+}
+
+void* allocateOrThrow(size_t size, size_t alignment) {
+    if (void* p = allocate(size, alignment)) return p;
+    throw std::bad_alloc{};
+}
+
+void deallocate(void* p) noexcept {
+    if (!p) return;
+    const Header* header = static_cast<Header*>(p) - 1;
+    liveBytes.fetch_sub(header->size, std::memory_order_relaxed);
+    std::free(header->base);
+}
+#endif
+
+} // namespace
+
+#ifdef AOC_TRACK_ALLOCATIONS
+bool AllocationTracker::enabled() {
+    return true;
+}
+#else
+bool AllocationTracker::enabled() {
+    return false;
+}
+#endif
+
+void AllocationTracker::start() {
+    startCount = allocationCount.load(std::memory_order_relaxed);
+    startBytes = allocatedBytes.load(std::memory_order_relaxed);
+    startLive = liveBytes.load(std::memory_order_relaxed);
+    peakLiveBytes.store(startLive, std::memory_order_relaxed);
+}
+
+AllocationStats AllocationTracker::stop() const {
+    const uint64_t peak = peakLiveBytes.load(std::memory_order_relaxed);
+    return {allocationCount.load(std::memory_order_relaxed) - startCount,
+            allocatedBytes.load(std::memory_order_relaxed) - startBytes, peak > startLive ? peak - startLive : 0};
+}
+
+} // namespace aoc
+
+#ifdef AOC_TRACK_ALLOCATIONS
+// Replacements of every global allocation function, see [replacement.functions]
+void* operator new(size_t size) {
+    return aoc::allocateOrThrow(size, 0);
+}
+void* operator new[](size_t size) {
+    return aoc::allocateOrThrow(size, 0);
+}
+void* operator new(size_t size, std::align_val_t alignment) {
+    return aoc::allocateOrThrow(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return aoc::allocateOrThrow(size, static_cast<size_t>(alignment));
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return aoc::allocate(size, 0);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return aoc::allocate(size, 0);
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return aoc::allocate(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return aoc::allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept {
+    aoc::deallocate(p);
+}
+void operator delete[](void* p) noexcept {
+    aoc::deallocate(p);
+}
+void operator delete(void* p, size_t) noexcept {
+    aoc::deallocate(p);
+}
+void operator delete[](void* p, size_t) noexcept {
+    aoc::deallocate(p);
+}
+void operator delete(void* p, std::align_val_t) noexcept {
+    aoc::deallocate(p);
+}
+void operator delete[](void* p, std::align_val_t) noexcept {
+    aoc::deallocate(p);
+}
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+    aoc::deallocate(p);
+}
+void operator delete[](void* p, size_t, std::align_val_t) noexcept {
+    aoc::deallocate(p);
+}
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    aoc::deallocate(p);
+}
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    aoc::deallocate(p);
+}
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    aoc::deallocate(p);
+}
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    aoc::deallocate(p);
+}
+#endif
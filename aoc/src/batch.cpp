@@ -0,0 +1,129 @@
+#include <aoc/batch.hpp>
+#include <aoc/prefetch.hpp>
+#include <aoc/thread_pool.hpp>
+#include <fmt/color.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+namespace aoc
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point startTime) {
+    return std::chrono::duration<double>(Clock::now() - startTime).count();
+}
+
+fmt::color getTimeColor(double seconds) {
+    return seconds < 0.1 ? fmt::color::light_green : seconds < 1.0 ? fmt::color::orange : fmt::color::orange_red;
+}
+
+std::string styledTime(double seconds) {
+    return fmt::format("{}", fmt::styled(fmt::format("{:.06f}s", seconds), fmt::fg(getTimeColor(seconds))));
+}
+
+// The parse time includes waiting for the prefetched text, the parts may keep views of it
+void solve(ThreadPool& pool, const Day& day, bool withPart2, std::optional<std::string_view> text, BatchResult& res) {
+    const auto parseStart = Clock::now();
+    if (!text) return;
+    res.opened = true;
+    res.bytes = text->size();
+    const auto parts = day.parse(*text);
+    res.parseSeconds = secondsSince(parseStart);
+    if (withPart2) {
+        pool.submit([&res, part2 = parts.part2] {
+            const auto part2Start = Clock::now();
+            res.answer2 = part2();
+            res.part2Seconds = secondsSince(part2Start);
+        });
+    }
+    const auto part1Start = Clock::now();
+    res.answer1 = parts.part1();
+    res.part1Seconds = secondsSince(part1Start);
+}
+
+} // namespace
+
+std::vector<std::string> expandInputs(const std::vector<std::string>& paths) {
+    std::vector<std::string> res;
+    for (const auto& path : paths) {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(path, ec)) {
+            res.push_back(path);
+            continue;
+        }
+        std::vector<std::string> files;
+        for (const auto& entry : std::filesystem::directory_iterator{path, ec})
+            if (entry.is_regular_file(ec)) files.push_back(entry.path().string());
+        std::ranges::sort(files);
+        res.insert(end(res), begin(files), end(files));
+    }
+    return res;
+}
+
+std::vector<BatchResult> solveBatch(const Day& day, const std::vector<std::string>& filenames, bool withPart2,
+                                    ThreadPool& pool) {
+    std::vector<BatchResult> res(filenames.size());
+    Prefetcher prefetcher{filenames};
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        res[i].filename = filenames[i];
+        pool.submit([&pool, &day, withPart2, &prefetcher, i, &result = res[i]] {
+            solve(pool, day, withPart2, prefetcher.text(i), result);
+        });
+    }
+    pool.wait();
+    return res;
+}
+
+int runBatch(const Day& day, bool test2, const std::vector<std::string>& paths, size_t threads) {
+    const auto filenames = expandInputs(paths);
+    if (filenames.empty()) {
+        fmt::print("No input file in the given directories\n");
+        return -1;
+    }
+    const auto startTime = Clock::now();
+    std::vector<BatchResult> results;
+    size_t usedThreads{};
+    {
+        if (threads > 0) ThreadPool::setSharedSize(threads);
+        ThreadPool& pool = ThreadPool::shared();
+        usedThreads = pool.size();
+        results = solveBatch(day, filenames, test2, pool);
+    }
+    const double wallSeconds = secondsSince(startTime);
+
+    const size_t width = std::ranges::max(results, {}, [](const auto& r) { return r.filename.size(); }).filename.size();
+    bool allOpened = true;
+    size_t totalBytes{};
+    double summedSeconds{};
+    for (const auto& result : results) {
+        fmt::print("{:<{}}  ", result.filename, width);
+        if (!result.opened) {
+            fmt::print("{}\n", fmt::styled("Cannot open", fmt::fg(fmt::color::red)));
+            allOpened = false;
+            continue;
+        }
+        fmt::print("Part 1: {}", fmt::styled(result.answer1, fmt::fg(fmt::color::yellow)));
+        if (test2) fmt::print("  Part 2: {}", fmt::styled(result.answer2, fmt::fg(fmt::color::yellow)));
+        fmt::print("  in {}\n", styledTime(result.seconds()));
+        totalBytes += result.bytes;
+        summedSeconds += result.seconds();
+    }
+    const double perSecond = wallSeconds > 0 ? 1.0 / wallSeconds : 0.0;
+    fmt::print("\n{} inputs, {:.2f} MB in {} wall: {:.1f} inputs/s, {:.2f} MB/s, {:.2f}x over {} threads\n",
+               results.size(), static_cast<double>(totalBytes) / 1e6, styledTime(wallSeconds),
+               static_cast<double>(results.size()) * perSecond, static_cast<double>(totalBytes) / 1e6 * perSecond,
+               summedSeconds * perSecond, usedThreads);
+    if (!allOpened) return -1;
+    return test2 ? 0 : 2;
+}
+
+} // namespace aoc
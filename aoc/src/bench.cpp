@@ -0,0 +1,291 @@
+#include <aoc/bench.hpp>
+#include <aoc/history.hpp>
+#include <fmt/color.h>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <numeric>
+#include <system_error>
+
+namespace aoc
+{
+
+namespace
+{
+
+std::optional<int> parseCount(std::string_view sv, int minValue) {
+    int value{};
+    const auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), value);
+    if (ec != std::errc{} || ptr != sv.data() + sv.size() || value < minValue) return std::nullopt;
+    return value;
+}
+
+void printUsage(std::string_view program) {
+    fmt::print("Usage: {} [--warmup N] [--reps N] [--json FILE] [--history FILE] [--trace FILE] [--profile FILE]\n"
+               "       [--counters] [--memory] [--memory-limit MB] [--sequential] [--stream] [--chunk BYTES]\n"
+               "       [--threads N] [--cache DIR] [--no-cache] [--verify-cache] [--check] [FILE|DIR...]\n",
+               program);
+    fmt::print("  --warmup N      untimed runs of each part before measuring (default 0)\n");
+    fmt::print("  --reps N        timed runs of each part (default 1)\n");
+    fmt::print("  --json FILE     write one JSON record per part to FILE\n");
+    fmt::print("  --history FILE  append the JSON records to FILE with the commit and preset, see aoc-compare\n");
+    fmt::print("  --trace FILE    write a Chrome trace of samples, parsing and parts to FILE (ui.perfetto.dev)\n");
+    fmt::print("  --profile FILE  sample the call stacks with SIGPROF into FILE, folded for flame graphs (Linux)\n");
+    fmt::print("  --counters      hardware counters per part (Linux perf_event_open)\n");
+    fmt::print("  --memory        peak resident set and page faults per part (Linux)\n");
+    fmt::print("  --memory-limit MB\n"
+               "                  stop with exit code 3 once the resident set is above MB megabytes (Linux)\n");
+    fmt::print("  --sequential    parse after the samples and part 2 after part 1 instead of overlapping them\n");
+    fmt::print("  --stream        solve both parts in one pass over the input, read a chunk at a time\n");
+    fmt::print("  --chunk BYTES   chunk size of --stream (default 1048576)\n");
+    fmt::print("  --threads N     worker threads of batch mode and parallel parts (default: hardware concurrency)\n");
+    fmt::print("  --cache DIR     directory of the answers of earlier runs, by input and build (default .aoc-cache)\n");
+    fmt::print("  --no-cache      neither look up nor record answers\n");
+    fmt::print("  --verify-cache  solve even when the answers are cached and fail if they differ\n");
+    fmt::print("  --check         compare the parts with their reference solutions, on FILE|DIR... too\n");
+    fmt::print("  FILE|DIR...     batch mode: solve every file, and every file of every directory, once each\n");
+}
+
+fmt::color getTimeColor(double seconds) {
+    return seconds < 0.1 ? fmt::color::light_green : seconds < 1.0 ? fmt::color::orange : fmt::color::orange_red;
+}
+
+std::string formatBytes(double bytes) {
+    return bytes >= 1e9 ? fmt::format("{:.2f} GB", bytes / 1e9)
+           : bytes >= 1e6 ? fmt::format("{:.2f} MB", bytes / 1e6)
+           : bytes >= 1e3 ? fmt::format("{:.2f} KB", bytes / 1e3)
+                          : fmt::format("{:.0f} B", bytes);
+}
+
+// Answers are numbers in every day but escape anyway so the output stays valid JSON
+std::string jsonEscape(std::string_view sv) {
+    std::string res;
+    res.reserve(sv.size());
+    for (char ch : sv) {
+        if (ch == '"' || ch == '\\') res += '\\';
+        res += ch;
+    }
+    return res;
+}
+
+} // namespace
+
+std::optional<BenchOptions> BenchOptions::fromArgs(int argc, char* argv[]) {
+    BenchOptions res;
+    const std::string_view program = argc > 0 ? argv[0] : "dayN";
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        std::optional<int> count;
+        if (arg == "--warmup" && hasValue && (count = parseCount(argv[i + 1], 0))) {
+            res.warmup = *count;
+            ++i;
+        } else if (arg == "--reps" && hasValue && (count = parseCount(argv[i + 1], 1))) {
+            res.repetitions = *count;
+            ++i;
+        } else if (arg == "--json" && hasValue) {
+            res.jsonFilename = argv[++i];
+        } else if (arg == "--history" && hasValue) {
+            res.historyFilename = argv[++i];
+        } else if (arg == "--trace" && hasValue) {
+            res.traceFilename = argv[++i];
+        } else if (arg == "--profile" && hasValue) {
+            res.profileFilename = argv[++i];
+        } else if (arg == "--counters") {
+            res.counters = true;
+        } else if (arg == "--memory") {
+            res.memory = true;
+        } else if (arg == "--memory-limit" && hasValue && (count = parseCount(argv[i + 1], 1))) {
+            res.memoryLimit = static_cast<uint64_t>(*count) * 1'000'000;
+            ++i;
+        } else if (arg == "--sequential") {
+            res.sequential = true;
+        } else if (arg == "--stream") {
+            res.stream = true;
+        } else if (arg == "--chunk" && hasValue && (count = parseCount(argv[i + 1], 1))) {
+            res.chunkSize = static_cast<size_t>(*count);
+            ++i;
+        } else if (arg == "--threads" && hasValue && (count = parseCount(argv[i + 1], 1))) {
+            res.threads = static_cast<size_t>(*count);
+            ++i;
+        } else if (arg == "--cache" && hasValue) {
+            res.cacheDirectory = argv[++i];
+        } else if (arg == "--no-cache") {
+            res.cacheDirectory.clear();
+        } else if (arg == "--verify-cache") {
+            res.verifyCache = true;
+        } else if (arg == "--check") {
+            res.check = true;
+        } else if (!arg.empty() && !arg.starts_with("--")) {
+            res.inputs.emplace_back(arg);
+        } else {
+            fmt::print("Invalid argument '{}'\n", arg);
+            printUsage(program);
+            return std::nullopt;
+        }
+    }
+    return res;
+}
+
+bool BenchOptions::measures() const {
+    return warmup > 0 || repetitions > 1 || !jsonFilename.empty() || !historyFilename.empty() ||
+           !traceFilename.empty() || !profileFilename.empty() || counters || memory;
+}
+
+std::optional<size_t> BenchOptions::sharedPoolSize(bool countersAvailable) const {
+    if (counters && countersAvailable && inputs.empty()) return 0;
+    if (threads > 0) return threads;
+    return std::nullopt;
+}
+
+BenchStats computeStats(std::vector<double> samples, size_t inputBytes) {
+    BenchStats res;
+    if (samples.empty()) return res;
+    std::ranges::sort(samples);
+    auto percentile = [&](double p) {
+        const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(samples.size())));
+        return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+    };
+    res.samples = samples.size();
+    res.min = samples.front();
+    res.median = percentile(0.50);
+    res.mean = std::accumulate(begin(samples), end(samples), 0.0) / static_cast<double>(samples.size());
+    res.p95 = percentile(0.95);
+    res.p99 = percentile(0.99);
+    res.bytesPerSecond = res.median > 0 ? static_cast<double>(inputBytes) / res.median : 0.0;
+    return res;
+}
+
+Bench::Bench(std::string_view dayName, std::string_view inputFilename, BenchOptions options)
+: dayName{dayName}, inputFilename{inputFilename}, options{std::move(options)} {
+    std::error_code ec;
+    inputBytes = static_cast<size_t>(std::filesystem::file_size(inputFilename, ec));
+    if (ec) inputBytes = 0;
+    if (!this->options.jsonFilename.empty()) {
+        jsonFile.open(this->options.jsonFilename);
+        if (!jsonFile) fmt::print("Cannot open '{}'\n", this->options.jsonFilename);
+    }
+    if (!this->options.historyFilename.empty()) {
+        historyFile.open(this->options.historyFilename, std::ios::app);
+        if (!historyFile) fmt::print("Cannot open '{}'\n", this->options.historyFilename);
+    }
+    if (this->options.counters) {
+        counters.emplace();
+        if (!counters->available()) {
+            fmt::print("Hardware counters are not available, check /proc/sys/kernel/perf_event_paranoid\n");
+            counters.reset();
+        }
+    }
+    if (this->options.memory && !MemoryTracker::available()) {
+        fmt::print("Memory usage is not available, it is read from /proc/self/status\n");
+        this->options.memory = false;
+    }
+}
+
+PerfCounters::Values Bench::averageCounters(const std::vector<PerfCounters::Values>& samples) {
+    PerfCounters::Values res;
+    if (samples.empty()) return res;
+    for (size_t event = 0; event < res.size(); ++event) {
+        double sum{};
+        const bool complete = std::ranges::all_of(samples, [&](const auto& values) {
+            sum += values[event].value_or(0.0);
+            return values[event].has_value();
+        });
+        if (complete) res[event] = sum / static_cast<double>(samples.size());
+    }
+    return res;
+}
+
+AllocationStats Bench::summarizeAllocations(const std::vector<AllocationStats>& samples) {
+    AllocationStats res;
+    if (samples.empty()) return res;
+    for (const auto& sample : samples) {
+        res.count += sample.count;
+        res.bytes += sample.bytes;
+        res.peakBytes = std::max(res.peakBytes, sample.peakBytes);
+    }
+    res.count /= samples.size();
+    res.bytes /= samples.size();
+    return res;
+}
+
+MemoryStats Bench::summarizeMemory(const std::vector<MemoryStats>& samples) {
+    MemoryStats res;
+    if (samples.empty()) return res;
+    for (const auto& sample : samples) {
+        res.peakRssBytes = std::max(res.peakRssBytes, sample.peakRssBytes);
+        res.minorFaults += sample.minorFaults;
+        res.majorFaults += sample.majorFaults;
+    }
+    res.minorFaults /= samples.size();
+    res.majorFaults /= samples.size();
+    return res;
+}
+
+bool Bench::allowsConcurrency() const {
+    return !options.sequential && !counters && !AllocationTracker::enabled() && !options.memory;
+}
+
+void Bench::report(const Timing& timing) {
+    const std::string_view name = timing.name;
+    const std::string_view answer = timing.answer;
+    const auto& measurement = timing.measurement;
+    const auto& stats = measurement.stats;
+    const std::string median = fmt::format("{:.06f}s", stats.median);
+    const auto time = fmt::styled(median, fmt::fg(getTimeColor(stats.median)));
+    if (answer.empty()) {
+        fmt::print("{} in {}", name, time);
+    } else {
+        fmt::print("{}: {} in {}", name, fmt::styled(answer, fmt::fg(fmt::color::yellow)), time);
+    }
+    if (stats.samples > 1) {
+        fmt::print(" (min {:.06f}s, p95 {:.06f}s, p99 {:.06f}s, {} runs, {:.2f} MB/s)", stats.min, stats.p95,
+                   stats.p99, stats.samples, stats.bytesPerSecond / 1e6);
+    }
+    if (counters) fmt::print(" [{}]", formatCounters(measurement.counters));
+    const auto& allocations = measurement.allocations;
+    if (AllocationTracker::enabled()) {
+        fmt::print(" {{{} allocs, {}, peak {}}}", allocations.count,
+                   formatBytes(static_cast<double>(allocations.bytes)),
+                   formatBytes(static_cast<double>(allocations.peakBytes)));
+    }
+    const auto& memory = measurement.memory;
+    if (options.memory) {
+        fmt::print(" <peak RSS +{}, {} minor, {} major faults>", formatBytes(static_cast<double>(memory.peakRssBytes)),
+                   memory.minorFaults, memory.majorFaults);
+    }
+    fmt::print("\n");
+    if (!jsonFile.is_open() && !historyFile.is_open()) return;
+    std::string extraFields;
+    if (counters) {
+        constexpr std::array<std::string_view, PerfCounters::kEventCount> kNames{
+            "cycles", "instructions", "l1dMisses", "llcMisses", "branchMisses"};
+        for (size_t event = 0; event < kNames.size(); ++event) {
+            const auto& v = measurement.counters[event];
+            extraFields += fmt::format(R"(, "{}": {})", kNames[event], v ? fmt::format("{:.0f}", *v) : "null");
+        }
+    }
+    if (AllocationTracker::enabled()) {
+        extraFields += fmt::format(R"(, "allocations": {}, "allocatedBytes": {}, "peakBytes": {})",
+                                     allocations.count, allocations.bytes, allocations.peakBytes);
+    }
+    if (options.memory) {
+        extraFields += fmt::format(R"(, "peakRssBytes": {}, "minorFaults": {}, "majorFaults": {})",
+                                     memory.peakRssBytes, memory.minorFaults, memory.majorFaults);
+    }
+    const std::string fields = fmt::format(
+        R"("input": "{}", "part": "{}", "answer": "{}", "inputBytes": {}, "warmup": {}, "samples": {}, "min": {:.9f}, )"
+        R"("median": {:.9f}, "mean": {:.9f}, "p95": {:.9f}, "p99": {:.9f}, "bytesPerSecond": {:.1f}{})",
+        jsonEscape(inputFilename), jsonEscape(name), jsonEscape(answer), inputBytes, options.warmup, stats.samples,
+        stats.min, stats.median, stats.mean, stats.p95, stats.p99, stats.bytesPerSecond, extraFields);
+    if (jsonFile.is_open()) jsonFile << "{" << fields << "}" << std::endl;
+    if (historyFile.is_open()) {
+        historyFile << fmt::format(R"({{"commit": "{}", "preset": "{}", "day": "{}", {}}})", jsonEscape(buildCommit()),
+                                   jsonEscape(buildPreset()), jsonEscape(dayName), fields)
+                    << std::endl;
+    }
+}
+
+} // namespace aoc
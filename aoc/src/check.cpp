@@ -0,0 +1,99 @@
+#include <aoc/check.hpp>
+#include <aoc/batch.hpp>
+#include <aoc/input.hpp>
+#include <fmt/color.h>
+#include <algorithm>
+#include <chrono>
+
+namespace aoc
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+template <class Fn>
+std::string timed(Fn&& fn, double& seconds) {
+    const auto startTime = Clock::now();
+    std::string res = fn();
+    seconds = std::chrono::duration<double>(Clock::now() - startTime).count();
+    return res;
+}
+
+void check(const Day& day, const Reference& reference, std::string_view text, CheckResult& res) {
+    res.opened = true;
+    res.answer = timed(
+        [&] {
+            const auto parts = day.parse(text);
+            return reference.part == 1 ? parts.part1() : parts.part2();
+        },
+        res.seconds);
+    res.referenceAnswer = timed([&] { return reference.solve(text); }, res.referenceSeconds);
+}
+
+std::string speedup(double seconds, double referenceSeconds) {
+    if (seconds <= 0) return "-";
+    const double ratio = referenceSeconds / seconds;
+    return fmt::format("{}", fmt::styled(fmt::format("{:.2f}x", ratio),
+                                         fmt::fg(ratio >= 1.0 ? fmt::color::light_green : fmt::color::orange_red)));
+}
+
+} // namespace
+
+std::vector<CheckResult> checkReferences(const Day& day, const std::vector<std::string>& paths) {
+    std::vector<std::string> filenames{std::string{day.inputFilename}};
+    const auto extra = expandInputs(paths);
+    filenames.insert(end(filenames), begin(extra), end(extra));
+    std::vector<CheckResult> res;
+    for (const auto& reference : day.references) {
+        for (size_t i = 0; i < day.samples.size(); ++i) {
+            if (day.samples[i].part != reference.part) continue;
+            auto& result = res.emplace_back(fmt::format("sample {}", i + 1), reference.part);
+            check(day, reference, day.samples[i].input, result);
+        }
+        for (const auto& filename : filenames) {
+            auto& result = res.emplace_back(filename, reference.part);
+            if (const MappedFile file{filename}) check(day, reference, file.text(), result);
+        }
+    }
+    return res;
+}
+
+int runCheck(const Day& day, const std::vector<std::string>& paths) {
+    if (day.references.empty()) {
+        fmt::print("{} has no reference to check against\n", day.name);
+        return -1;
+    }
+    const auto results = checkReferences(day, paths);
+    const size_t width = std::ranges::max(results, {}, [](const auto& r) { return r.input.size(); }).input.size();
+    bool allAgree = true;
+    for (const auto& result : results) {
+        fmt::print("{:<{}}  Part {}: ", result.input, width, result.part);
+        allAgree &= result.agrees();
+        if (!result.opened) {
+            fmt::print("{}\n", fmt::styled("Cannot open", fmt::fg(fmt::color::red)));
+        } else if (!result.agrees()) {
+            fmt::print("{}\n", fmt::styled(fmt::format("{}, reference {}", result.answer, result.referenceAnswer),
+                                           fmt::fg(fmt::color::red)));
+        } else {
+            fmt::print("{} in {:.06f}s, reference {:.06f}s ({})\n",
+                       fmt::styled(result.answer, fmt::fg(fmt::color::yellow)), result.seconds,
+                       result.referenceSeconds, speedup(result.seconds, result.referenceSeconds));
+        }
+    }
+    for (const auto& reference : day.references) {
+        double seconds{}, referenceSeconds{};
+        for (const auto& result : results) {
+            if (result.part != reference.part || !result.agrees()) continue;
+            seconds += result.seconds;
+            referenceSeconds += result.referenceSeconds;
+        }
+        fmt::print("\nPart {}: {:.06f}s against {:.06f}s for the reference ({})", reference.part, seconds,
+                   referenceSeconds, speedup(seconds, referenceSeconds));
+    }
+    fmt::print("\n");
+    return allAgree ? 0 : -1;
+}
+
+} // namespace aoc
@@ -0,0 +1,158 @@
+#include <aoc/day.hpp>
+#include <aoc/batch.hpp>
+#include <aoc/bench.hpp>
+#include <aoc/check.hpp>
+#include <aoc/input.hpp>
+#include <aoc/memory_tracker.hpp>
+#include <aoc/perf_counters.hpp>
+#include <aoc/profiler.hpp>
+#include <aoc/result_cache.hpp>
+#include <aoc/thread_pool.hpp>
+#include <aoc/trace.hpp>
+#include <fmt/color.h>
+#include <functional>
+#include <future>
+#include <optional>
+#include <tuple>
+
+namespace aoc
+{
+
+std::pair<bool, bool> Day::test() const {
+    const TraceSpan span{name, "test"};
+    std::pair<bool, bool> res{true, hasPart2};
+    for (const auto& sample : samples) {
+        if (sample.checkedAtBuild) continue;
+        const std::string answer = sample.parse(sample.input)();
+        const bool correct = answer == sample.answer;
+        fmt::print("Part {}: expected {}, got {}\n", sample.part, sample.answer,
+                   fmt::styled(answer, fmt::fg(correct ? fmt::color::green : fmt::color::red)));
+        (sample.part == 1 ? res.first : res.second) &= correct;
+    }
+    return res;
+}
+
+namespace
+{
+
+// Real input, parsed: the parts keep views of the mapping
+struct LoadedInput {
+    Parts parts;
+    Bench::Timing parse;
+};
+
+LoadedInput loadInput(const Day& day, const MappedFile& file, Bench& bench) {
+    LoadedInput res;
+    std::tie(res.parts, res.parse) = bench.timeResult("Parse", [&] { return day.parse(file.text()); });
+    return res;
+}
+
+// One pass over the real input read a chunk at a time, for inputs too large to map and parse whole
+int runStream(const Day& day, bool test2, const BenchOptions& options) {
+    if (!day.stream) {
+        fmt::print("{} has no streaming mode\n", day.name);
+        return -1;
+    }
+    Bench bench{day.name, day.inputFilename, options};
+    const auto answers = bench.measure("Stream", [&] { return day.stream(day.inputFilename, options.chunkSize); });
+    if (!answers) {
+        fmt::print("Cannot open '{}'\n", day.inputFilename);
+        return -1;
+    }
+    fmt::print("Part 1: {}\n", answers->first);
+    if (!test2) return 2;
+    fmt::print("Part 2: {}\n", answers->second);
+    return 0;
+}
+
+// nullopt without a cache, or when the input cannot be read, which the run reports
+std::optional<ResultCache> openCache(const Day& day, const MappedFile& file, const BenchOptions& options) {
+    if (options.cacheDirectory.empty() || !file) return std::nullopt;
+    return ResultCache{options.cacheDirectory, day.name, file.text()};
+}
+
+// Answers cached by an earlier run, printed instead of solving the day
+int printCached(const ResultCache::Answers& answers) {
+    fmt::print("Part 1: {} (cached)\n", fmt::styled(answers.part1, fmt::fg(fmt::color::yellow)));
+    if (!answers.part2) return 2;
+    fmt::print("Part 2: {} (cached)\n", fmt::styled(*answers.part2, fmt::fg(fmt::color::yellow)));
+    return 0;
+}
+
+// Records the answers just solved, after comparing them with the cached ones with --verify-cache. -1 when they differ.
+int recordAnswers(const ResultCache& cache, bool verify, const ResultCache::Answers& answers) {
+    if (verify) {
+        const auto cached = cache.load();
+        if (!cached) {
+            fmt::print("No cached answers to verify\n");
+        } else if (*cached != answers) {
+            fmt::print("{}\n", fmt::styled(fmt::format("Cached answers differ: part 1 {}, part 2 {}", cached->part1,
+                                                       cached->part2.value_or("none")),
+                                           fmt::fg(fmt::color::red)));
+            return -1; // the entry stays as it was, delete it to record the new answers
+        } else {
+            fmt::print("Cached answers match\n");
+        }
+    }
+    if (!cache.store(answers)) fmt::print("Cannot write '{}'\n", cache.path());
+    return 0;
+}
+
+} // namespace
+
+int runDay(const Day& day, int argc, char* argv[]) {
+    const auto benchOptions = BenchOptions::fromArgs(argc, argv);
+    if (!benchOptions) return -1;
+    const TraceSession trace{benchOptions->traceFilename};
+    const Profiler profiler{benchOptions->profileFilename};
+    const MemoryBudget memoryBudget{benchOptions->memoryLimit};
+    const bool countersAvailable = benchOptions->counters && PerfCounters{}.available();
+    if (const auto poolSize = benchOptions->sharedPoolSize(countersAvailable)) ThreadPool::setSharedSize(*poolSize);
+    if (benchOptions->check) return runCheck(day, benchOptions->inputs);
+    if (!benchOptions->inputs.empty() || benchOptions->stream) {
+        auto [test1, test2] = day.test();
+        if (!test1) return 1;
+        if (benchOptions->stream) return runStream(day, test2, *benchOptions);
+        return runBatch(day, test2, benchOptions->inputs, benchOptions->threads);
+    }
+
+    // A plain run on an input solved before by the same build prints the answers it found, without checking the
+    // samples again. Runs that measure always solve, but still record the answers.
+    const MappedFile file{day.inputFilename};
+    const auto cache = openCache(day, file, *benchOptions);
+    if (cache && !benchOptions->verifyCache && !benchOptions->measures()) {
+        if (const auto cached = cache->load()) return printCached(*cached);
+    }
+
+    // The input is loaded and parsed while the samples run, and part 2 runs next to part 1. Results are still
+    // reported in order, and only once the samples of their part passed.
+    Bench bench{day.name, day.inputFilename, *benchOptions};
+    const bool concurrent = bench.allowsConcurrency();
+    std::future<LoadedInput> loading;
+    if (concurrent && file)
+        loading = std::async(std::launch::async, loadInput, std::cref(day), std::cref(file), std::ref(bench));
+    auto [test1, test2] = day.test();
+    if (!test1) return 1;
+    if (!file) {
+        fmt::print("Cannot open '{}'\n", day.inputFilename);
+        return -1;
+    }
+    const LoadedInput input = loading.valid() ? loading.get() : loadInput(day, file, bench);
+    bench.report(input.parse);
+
+    std::future<Bench::Timing> part2;
+    if (concurrent && test2)
+        part2 = std::async(std::launch::async, [&] { return bench.time("Part 2", input.parts.part2); });
+    const auto part1 = bench.time("Part 1", input.parts.part1);
+    bench.report(part1);
+    ResultCache::Answers answers{part1.answer, std::nullopt};
+    if (test2) {
+        const auto timing = part2.valid() ? part2.get() : bench.time("Part 2", input.parts.part2);
+        bench.report(timing);
+        answers.part2 = timing.answer;
+    }
+    if (cache && recordAnswers(*cache, benchOptions->verifyCache, answers) != 0) return -1;
+    return test2 ? 0 : 2;
+}
+
+} // namespace aoc
@@ -0,0 +1,101 @@
+#include <aoc/history.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+namespace aoc
+{
+
+namespace
+{
+
+// Records are written by Bench, which only escapes '"' and '\', so this is all the JSON they need
+std::optional<std::string> stringField(std::string_view line, std::string_view key) {
+    const std::string prefix = fmt::format(R"("{}": ")", key);
+    const size_t start = line.find(prefix);
+    if (start == std::string_view::npos) return std::nullopt;
+    std::string res;
+    for (size_t i = start + prefix.size(); i < line.size(); ++i) {
+        if (line[i] == '"') return res;
+        if (line[i] == '\\' && ++i == line.size()) break;
+        res += line[i];
+    }
+    return std::nullopt;
+}
+
+std::optional<double> numberField(std::string_view line, std::string_view key) {
+    const std::string prefix = fmt::format(R"("{}": )", key);
+    const size_t start = line.find(prefix);
+    if (start == std::string_view::npos) return std::nullopt;
+    // strtod rather than from_chars, which not every standard library has for floating point yet
+    const std::string value{line.substr(start + prefix.size(), 32)};
+    char* end{};
+    const double res = std::strtod(value.c_str(), &end);
+    if (end == value.c_str()) return std::nullopt;
+    return res;
+}
+
+} // namespace
+
+std::optional<HistoryRecord> parseHistoryRecord(std::string_view line) {
+    auto commit = stringField(line, "commit");
+    auto preset = stringField(line, "preset");
+    auto day = stringField(line, "day");
+    auto part = stringField(line, "part");
+    const auto median = numberField(line, "median");
+    if (!commit || !preset || !day || !part || !median) return std::nullopt;
+    return HistoryRecord{std::move(*commit), std::move(*preset), std::move(*day), std::move(*part), *median};
+}
+
+std::optional<std::vector<HistoryRecord>> readHistory(const std::string& filename) {
+    std::ifstream file{filename};
+    if (!file) return std::nullopt;
+    std::vector<HistoryRecord> res;
+    for (std::string line; std::getline(file, line);)
+        if (auto record = parseHistoryRecord(line)) res.push_back(std::move(*record));
+    return res;
+}
+
+std::optional<std::pair<std::string, std::string>> latestCommits(const std::vector<HistoryRecord>& records,
+                                                                  std::string_view preset) {
+    std::vector<std::string_view> commits;
+    for (const auto& record : records) {
+        if (record.preset != preset) continue;
+        std::erase(commits, record.commit);
+        commits.push_back(record.commit);
+    }
+    if (commits.size() < 2) return std::nullopt;
+    return std::pair{std::string{commits[commits.size() - 2]}, std::string{commits.back()}};
+}
+
+std::vector<HistoryChange> compareHistory(const std::vector<HistoryRecord>& records, std::string_view preset,
+                                          std::string_view baseline, std::string_view current) {
+    // Filled in for both commits first so phases missing at either one can be dropped
+    std::vector<HistoryChange> changes;
+    std::vector<std::pair<bool, bool>> measured;
+    for (const auto& record : records) {
+        const bool isBaseline = record.commit == baseline;
+        if (record.preset != preset || (!isBaseline && record.commit != current)) continue;
+        auto it = std::ranges::find_if(changes, [&](const auto& c) {
+            return c.day == record.day && c.part == record.part;
+        });
+        if (it == end(changes)) {
+            it = changes.insert(end(changes), {record.day, record.part});
+            measured.emplace_back();
+        }
+        auto& [hasBaseline, hasCurrent] = measured[static_cast<size_t>(it - begin(changes))];
+        auto update = [&](double& median, bool& has) {
+            median = has ? std::min(median, record.median) : record.median;
+            has = true;
+        };
+        if (isBaseline) update(it->baseline, hasBaseline);
+        if (record.commit == current) update(it->current, hasCurrent);
+    }
+    std::vector<HistoryChange> res;
+    for (size_t i = 0; i < changes.size(); ++i)
+        if (measured[i].first && measured[i].second) res.push_back(std::move(changes[i]));
+    return res;
+}
+
+} // namespace aoc
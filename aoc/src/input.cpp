@@ -0,0 +1,122 @@
+#include <aoc/input.hpp>
+#include <aoc/trace.hpp>
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace aoc
+{
+
+#ifdef _WIN32
+MappedFile::MappedFile(std::string_view filename) {
+    const TraceSpan span{"io", "open", "file", filename};
+    const HANDLE file = CreateFileA(std::string{filename}.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return;
+    LARGE_INTEGER fileSize{};
+    const bool hasSize = GetFileSizeEx(file, &fileSize) != 0;
+    if (hasSize && fileSize.QuadPart == 0) {
+        isOpen = true; // CreateFileMapping rejects empty files
+    } else if (hasSize) {
+        if (const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+            data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping); // the view keeps the mapping alive
+            size = data ? static_cast<size_t>(fileSize.QuadPart) : 0;
+            isOpen = data != nullptr;
+        }
+    }
+    CloseHandle(file);
+}
+
+void MappedFile::close() {
+    if (data) UnmapViewOfFile(data);
+}
+#else
+MappedFile::MappedFile(std::string_view filename) {
+    const TraceSpan span{"io", "open", "file", filename};
+    const int fd = ::open(std::string{filename}.c_str(), O_RDONLY);
+    if (fd == -1) return;
+    struct stat st{};
+    const bool hasSize = ::fstat(fd, &st) == 0;
+    if (hasSize && st.st_size == 0) {
+        isOpen = true; // mmap rejects empty files
+    } else if (hasSize) {
+        void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            ::madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+            data = static_cast<const char*>(p);
+            size = static_cast<size_t>(st.st_size);
+            isOpen = true;
+        }
+    }
+    ::close(fd); // the mapping stays valid after the descriptor is closed
+}
+
+void MappedFile::close() {
+    if (data) ::munmap(const_cast<char*>(data), size);
+}
+#endif
+
+ChunkReader::ChunkReader(std::string_view filename, std::string_view separators, size_t chunkSize)
+: file{std::fopen(std::string{filename}.c_str(), "rb"), std::fclose}, separators{separators},
+  buffer(std::max<size_t>(chunkSize, 1)) {
+#ifndef _WIN32
+    // fopen opens a directory as well, which then reads as an empty input. Pipes stay, they are what streams.
+    struct stat st{};
+    if (file && (::fstat(::fileno(file.get()), &st) != 0 || S_ISDIR(st.st_mode))) file.reset();
+#endif
+}
+
+std::string_view ChunkReader::next() {
+    // The unfinished record the last chunk stopped before moves to the front
+    std::copy(buffer.begin() + static_cast<ptrdiff_t>(handedOut), buffer.begin() + static_cast<ptrdiff_t>(filled),
+              buffer.begin());
+    filled -= handedOut;
+    handedOut = 0;
+    while (file) {
+        if (filled == buffer.size()) buffer.resize(buffer.size() * 2);
+        const size_t count = std::fread(buffer.data() + filled, 1, buffer.size() - filled, file.get());
+        if (count == 0) break;
+        const std::string_view read{buffer.data() + filled, count};
+        filled += count;
+        if (const size_t last = read.find_last_of(separators); last != read.npos) {
+            handedOut = filled - count + last + 1;
+            return {buffer.data(), handedOut};
+        }
+    }
+    // End of the file, what is left is its last record
+    handedOut = filled;
+    return {buffer.data(), filled};
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+: data{std::exchange(other.data, nullptr)}, size{std::exchange(other.size, 0)},
+  isOpen{std::exchange(other.isOpen, false)} {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+        isOpen = std::exchange(other.isOpen, false);
+    }
+    return *this;
+}
+
+} // namespace aoc
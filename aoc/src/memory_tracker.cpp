@@ -0,0 +1,136 @@
+#include <aoc/memory_tracker.hpp>
+#include <fmt/format.h>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <string_view>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace aoc
+{
+
+#ifdef __linux__
+namespace
+{
+
+// Whole small /proc file, read without allocating since the budget thread reads it every few milliseconds
+std::string_view readProcFile(const char* path, std::span<char> buffer) {
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) return {};
+    const ssize_t size = ::read(fd, buffer.data(), buffer.size());
+    ::close(fd);
+    return size > 0 ? std::string_view{buffer.data(), static_cast<size_t>(size)} : std::string_view{};
+}
+
+// "VmRSS:     1256 kB" line of /proc/self/status in bytes
+uint64_t statusField(std::string_view status, std::string_view field) {
+    const size_t pos = status.find(field);
+    if (pos == std::string_view::npos) return 0;
+    uint64_t kilobytes{};
+    for (size_t i = pos + field.size(); i < status.size() && status[i] != '\n'; ++i)
+        if (status[i] >= '0' && status[i] <= '9') kilobytes = kilobytes * 10 + static_cast<uint64_t>(status[i] - '0');
+    return kilobytes * 1024;
+}
+
+struct Resident {
+    uint64_t current{};
+    uint64_t peak{};
+};
+
+Resident readResident() {
+    std::array<char, 4096> buffer;
+    const auto status = readProcFile("/proc/self/status", buffer);
+    return {statusField(status, "\nVmRSS:"), statusField(status, "\nVmHWM:")};
+}
+
+// Writing 5 to clear_refs sets VmHWM back to VmRSS, since Linux 4.0
+bool resetPeak() {
+    const int fd = ::open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+    if (fd == -1) return false;
+    const bool res = ::write(fd, "5", 1) == 1;
+    ::close(fd);
+    return res;
+}
+
+} // namespace
+
+bool MemoryTracker::available() {
+    return readResident().current > 0;
+}
+
+void MemoryTracker::start() {
+    peakReset = resetPeak();
+    const auto resident = readResident();
+    startRss = resident.current;
+    startPeak = resident.peak;
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    startMinorFaults = static_cast<uint64_t>(usage.ru_minflt);
+    startMajorFaults = static_cast<uint64_t>(usage.ru_majflt);
+}
+
+MemoryStats MemoryTracker::stop() const {
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    const auto resident = readResident();
+    // Without the reset the kernel's peak only says something when the phase went above the peak before it, else the
+    // resident set at the end is the best guess
+    const uint64_t peak = peakReset || resident.peak > startPeak ? resident.peak : resident.current;
+    return {peak > startRss ? peak - startRss : 0, static_cast<uint64_t>(usage.ru_minflt) - startMinorFaults,
+            static_cast<uint64_t>(usage.ru_majflt) - startMajorFaults};
+}
+
+uint64_t residentBytes() {
+    // Second field of statm, in pages
+    std::array<char, 256> buffer;
+    const auto statm = readProcFile("/proc/self/statm", buffer);
+    const size_t space = statm.find(' ');
+    if (space == std::string_view::npos) return 0;
+    uint64_t pages{};
+    for (size_t i = space + 1; i < statm.size() && statm[i] >= '0' && statm[i] <= '9'; ++i)
+        pages = pages * 10 + static_cast<uint64_t>(statm[i] - '0');
+    return pages * static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+}
+
+MemoryBudget::MemoryBudget(uint64_t limitBytes) {
+    if (limitBytes == 0) return;
+    watcher = std::jthread{[limitBytes](std::stop_token stop) {
+        while (!stop.stop_requested()) {
+            if (const uint64_t rss = residentBytes(); rss > limitBytes) {
+                fmt::print("\nMemory limit of {:.1f} MB exceeded with {:.1f} MB resident, stopping\n",
+                           static_cast<double>(limitBytes) / 1e6, static_cast<double>(rss) / 1e6);
+                std::fflush(stdout);
+                std::_Exit(kExitCode);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds{5});
+        }
+    }};
+}
+#else
+bool MemoryTracker::available() {
+    return false;
+}
+
+void MemoryTracker::start() {}
+
+MemoryStats MemoryTracker::stop() const {
+    return {};
+}
+
+uint64_t residentBytes() {
+    return 0;
+}
+
+MemoryBudget::MemoryBudget(uint64_t limitBytes) {
+    if (limitBytes != 0) fmt::print("Memory limits are only supported on Linux\n");
+}
+#endif
+
+} // namespace aoc
@@ -0,0 +1,111 @@
+#include <aoc/perf_counters.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <cstdint>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace aoc
+{
+
+#ifdef __linux__
+namespace
+{
+
+int openEvent(uint32_t type, uint64_t config) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1; // allowed with the default perf_event_paranoid
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+} // namespace
+
+PerfCounters::PerfCounters() {
+    constexpr uint64_t kL1dReadMiss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    fds[kCycles] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    fds[kInstructions] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    fds[kL1dMisses] = openEvent(PERF_TYPE_HW_CACHE, kL1dReadMiss);
+    fds[kLlcMisses] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    fds[kBranchMisses] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds)
+        if (fd != -1) ::close(fd);
+}
+
+void PerfCounters::start() {
+    for (int fd : fds) {
+        if (fd == -1) continue;
+        ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+PerfCounters::Values PerfCounters::stop() {
+    for (int fd : fds)
+        if (fd != -1) ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    Values res;
+    for (size_t i = 0; i < fds.size(); ++i) {
+        struct {
+            uint64_t value, timeEnabled, timeRunning;
+        } data{};
+        if (fds[i] == -1 || ::read(fds[i], &data, sizeof(data)) != sizeof(data)) continue;
+        const double scale = data.timeRunning ? static_cast<double>(data.timeEnabled) / data.timeRunning : 1.0;
+        res[i] = static_cast<double>(data.value) * scale;
+    }
+    return res;
+}
+#else
+PerfCounters::PerfCounters() {
+    fds.fill(-1);
+}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::start() {}
+
+PerfCounters::Values PerfCounters::stop() {
+    return {};
+}
+#endif
+
+bool PerfCounters::available() const {
+    return std::ranges::any_of(fds, [](int fd) { return fd != -1; });
+}
+
+std::string formatCounters(const PerfCounters::Values& values) {
+    auto humanize = [](double v) {
+        return v >= 1e9 ? fmt::format("{:.2f}G", v / 1e9)
+               : v >= 1e6 ? fmt::format("{:.2f}M", v / 1e6)
+               : v >= 1e3 ? fmt::format("{:.2f}K", v / 1e3)
+                          : fmt::format("{:.0f}", v);
+    };
+    std::string res;
+    auto append = [&](std::string_view name, const std::optional<double>& v) {
+        if (!v) return;
+        res += fmt::format("{}{} {}", res.empty() ? "" : ", ", name, humanize(*v));
+    };
+    append("cycles", values[PerfCounters::kCycles]);
+    append("instr", values[PerfCounters::kInstructions]);
+    if (values[PerfCounters::kCycles] && values[PerfCounters::kInstructions] && *values[PerfCounters::kCycles] > 0)
+        res += fmt::format(", IPC {:.2f}", *values[PerfCounters::kInstructions] / *values[PerfCounters::kCycles]);
+    append("L1d miss", values[PerfCounters::kL1dMisses]);
+    append("LLC miss", values[PerfCounters::kLlcMisses]);
+    append("branch miss", values[PerfCounters::kBranchMisses]);
+    return res;
+}
+
+} // namespace aoc
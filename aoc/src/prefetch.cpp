@@ -0,0 +1,309 @@
+#include <aoc/prefetch.hpp>
+#include <aoc/thread_pool.hpp>
+#include <aoc/trace.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace aoc
+{
+
+namespace
+{
+
+enum State : int { kQueued, kReading, kReady, kFailed };
+
+} // namespace
+
+struct Prefetcher::File {
+    std::string filename;
+    std::unique_ptr<char[]> data;
+    size_t size{};
+    std::atomic<int> state{kQueued};
+
+    void finish(bool ok) {
+        state.store(ok ? kReady : kFailed, std::memory_order_release);
+        state.notify_all();
+    }
+};
+
+namespace
+{
+
+#ifdef _WIN32
+bool readWhole(Prefetcher::File& file) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(file.filename, ec);
+    if (ec) return false;
+    std::FILE* stream = std::fopen(file.filename.c_str(), "rb");
+    if (!stream) return false;
+    file.data = std::make_unique_for_overwrite<char[]>(size);
+    file.size = std::fread(file.data.get(), 1, size, stream);
+    const bool ok = !std::ferror(stream);
+    std::fclose(stream);
+    return ok;
+}
+#else
+// Open and size the file, the buffer is allocated but not filled. -1 when it cannot be opened.
+int openFile(Prefetcher::File& file) {
+    const int fd = ::open(file.filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) return -1;
+    struct stat st{};
+    if (::fstat(fd, &st) == -1 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return -1;
+    }
+    file.size = static_cast<size_t>(st.st_size);
+    file.data = std::make_unique_for_overwrite<char[]>(file.size);
+    return fd;
+}
+
+// Fills the buffer from `done` on, a file that shrank since it was sized keeps what could be read
+bool preadRest(Prefetcher::File& file, int fd, size_t done) {
+    while (done < file.size) {
+        const ssize_t n = ::pread(fd, file.data.get() + done, file.size - done, static_cast<off_t>(done));
+        if (n == -1 && errno == EINTR) continue;
+        if (n == -1) return false;
+        if (n == 0) break;
+        done += static_cast<size_t>(n);
+    }
+    file.size = done;
+    return true;
+}
+
+bool readWhole(Prefetcher::File& file) {
+    const int fd = openFile(file);
+    if (fd == -1) return false;
+    const bool ok = preadRest(file, fd, 0);
+    ::close(fd);
+    return ok;
+}
+#endif
+
+// Whoever claims a queued file first reads it: the task submitted for it, or a thread that cannot wait any longer
+void claimAndRead(Prefetcher::File& file) {
+    int expected = kQueued;
+    if (!file.state.compare_exchange_strong(expected, kReading, std::memory_order_acq_rel)) return;
+    const TraceSpan span{"io", "pread", "file", file.filename};
+    file.finish(readWhole(file));
+}
+
+} // namespace
+
+#ifdef __linux__
+// The three shared mappings of an io_uring and the few ring fields used, set up with the raw syscalls: liburing is not
+// a dependency. Only the ring thread touches it once created.
+struct Prefetcher::Ring {
+    static constexpr unsigned kEntries = 64;
+
+    int fd{-1};
+    void* sqRing{MAP_FAILED};
+    size_t sqRingSize{};
+    void* cqRing{MAP_FAILED};
+    size_t cqRingSize{};
+    io_uring_sqe* sqes{static_cast<io_uring_sqe*>(MAP_FAILED)};
+    size_t sqesSize{};
+    io_uring_params params{};
+    unsigned unsubmitted{};
+
+    // nullptr when the kernel has no io_uring or does not let this process use it
+    static std::unique_ptr<Ring> create() {
+        auto ring = std::make_unique<Ring>();
+        ring->fd = static_cast<int>(::syscall(SYS_io_uring_setup, kEntries, &ring->params));
+        if (ring->fd == -1) return nullptr;
+        const auto& p = ring->params;
+        ring->sqRingSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        ring->cqRingSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        const bool singleMap = p.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMap) ring->sqRingSize = ring->cqRingSize = std::max(ring->sqRingSize, ring->cqRingSize);
+        ring->sqRing = ring->map(ring->sqRingSize, IORING_OFF_SQ_RING);
+        ring->cqRing = singleMap ? ring->sqRing : ring->map(ring->cqRingSize, IORING_OFF_CQ_RING);
+        ring->sqesSize = p.sq_entries * sizeof(io_uring_sqe);
+        ring->sqes = static_cast<io_uring_sqe*>(ring->map(ring->sqesSize, IORING_OFF_SQES));
+        if (ring->sqRing == MAP_FAILED || ring->cqRing == MAP_FAILED || ring->sqes == MAP_FAILED) return nullptr;
+        return ring;
+    }
+
+    ~Ring() {
+        if (sqes != MAP_FAILED) ::munmap(sqes, sqesSize);
+        if (cqRing != MAP_FAILED && cqRing != sqRing) ::munmap(cqRing, cqRingSize);
+        if (sqRing != MAP_FAILED) ::munmap(sqRing, sqRingSize);
+        if (fd != -1) ::close(fd);
+    }
+
+    void* map(size_t size, off_t offset) const {
+        return ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    }
+    unsigned& sqField(unsigned offset) const {
+        return *reinterpret_cast<unsigned*>(static_cast<char*>(sqRing) + offset);
+    }
+    unsigned& cqField(unsigned offset) const {
+        return *reinterpret_cast<unsigned*>(static_cast<char*>(cqRing) + offset);
+    }
+
+    unsigned capacity() const { return params.sq_entries; }
+
+    // Queues a read of `size` bytes at `offset` of `fd` into `buffer`, submitted by the next enter()
+    void queueRead(int readFd, char* buffer, size_t size, size_t offset, uint64_t userData) {
+        const unsigned tail = sqField(params.sq_off.tail);
+        const unsigned index = tail & sqField(params.sq_off.ring_mask);
+        io_uring_sqe& sqe = sqes[index];
+        sqe = {};
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = readFd;
+        sqe.addr = reinterpret_cast<uint64_t>(buffer);
+        sqe.len = static_cast<uint32_t>(std::min<size_t>(size, 1u << 30));
+        sqe.off = offset;
+        sqe.user_data = userData;
+        (&sqField(params.sq_off.array))[index] = index;
+        std::atomic_ref{sqField(params.sq_off.tail)}.store(tail + 1, std::memory_order_release);
+        ++unsubmitted;
+    }
+
+    // Submits the queued reads and waits for at least one completion. False when the ring failed.
+    bool enter() {
+        for (;;) {
+            const long n = ::syscall(SYS_io_uring_enter, fd, unsubmitted, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (n >= 0) {
+                unsubmitted -= static_cast<unsigned>(n);
+                return true;
+            }
+            if (errno != EINTR && errno != EAGAIN && errno != EBUSY) return false;
+        }
+    }
+
+    // Calls `fn(userData, res)` for every completion available
+    template <class Fn>
+    void reap(Fn fn) {
+        std::atomic_ref head{cqField(params.cq_off.head)};
+        const unsigned tail = std::atomic_ref{cqField(params.cq_off.tail)}.load(std::memory_order_acquire);
+        const unsigned mask = cqField(params.cq_off.ring_mask);
+        const auto* cqes = reinterpret_cast<const io_uring_cqe*>(static_cast<char*>(cqRing) + params.cq_off.cqes);
+        for (unsigned i = head.load(std::memory_order_relaxed); i != tail; ++i) {
+            const io_uring_cqe cqe = cqes[i & mask];
+            head.store(i + 1, std::memory_order_release);
+            fn(cqe.user_data, cqe.res);
+        }
+    }
+};
+
+namespace
+{
+
+// Opens files and keeps up to capacity() reads in flight until every file is read, a short read is queued again for
+// the rest. A read the ring refuses, like IORING_OP_READ before Linux 5.6, falls back to pread.
+void runRing(Prefetcher::Ring& ring, std::vector<Prefetcher::File>& files, std::stop_token stop) {
+    const TraceSpan span{"io", "io_uring", "files", static_cast<int64_t>(files.size())};
+    std::vector<int> fds(files.size(), -1);
+    std::vector<size_t> done(files.size());
+    size_t next = 0;
+    unsigned inFlight = 0;
+    auto finish = [&](size_t i, bool ok) {
+        ::close(fds[i]);
+        files[i].finish(ok);
+    };
+    while (inFlight > 0 || (next < files.size() && !stop.stop_requested())) {
+        for (; next < files.size() && inFlight < ring.capacity() && !stop.stop_requested(); ++next) {
+            auto& file = files[next];
+            int expected = kQueued;
+            if (!file.state.compare_exchange_strong(expected, kReading, std::memory_order_acq_rel)) continue;
+            fds[next] = openFile(file);
+            if (fds[next] == -1) {
+                file.finish(false);
+            } else if (file.size == 0) {
+                finish(next, true);
+            } else {
+                ring.queueRead(fds[next], file.data.get(), file.size, 0, next);
+                ++inFlight;
+            }
+        }
+        if (inFlight == 0) continue;
+        if (!ring.enter()) {
+            // The reads in flight may still land in their buffers, which stay alive with the prefetcher
+            for (size_t i = 0; i < next; ++i)
+                if (files[i].state.load(std::memory_order_acquire) == kReading) finish(i, false);
+            for (; next < files.size(); ++next) claimAndRead(files[next]);
+            return;
+        }
+        ring.reap([&](uint64_t i, int res) {
+            auto& file = files[i];
+            if (res < 0 && res != -EINTR && res != -EAGAIN) {
+                --inFlight;
+                finish(i, preadRest(file, fds[i], done[i]));
+                return;
+            }
+            done[i] += static_cast<size_t>(std::max(res, 0));
+            if (res != 0 && done[i] < file.size) {
+                ring.queueRead(fds[i], file.data.get() + done[i], file.size - done[i], done[i], i);
+                return;
+            }
+            --inFlight;
+            file.size = done[i];
+            finish(i, true);
+        });
+    }
+}
+
+} // namespace
+#else
+struct Prefetcher::Ring {};
+#endif
+
+Prefetcher::Prefetcher(std::vector<std::string> filenames)
+: files{std::make_shared<std::vector<File>>(filenames.size())} {
+    for (size_t i = 0; i < filenames.size(); ++i) (*files)[i].filename = std::move(filenames[i]);
+#ifdef __linux__
+    ring = Ring::create();
+    if (ring) {
+        ringThread = std::jthread{[this](std::stop_token stop) { runRing(*ring, *files, stop); }};
+        return;
+    }
+#endif
+    auto& pool = ThreadPool::shared();
+    for (size_t i = 0; i < files->size(); ++i) pool.submit([files = files, i] { claimAndRead((*files)[i]); });
+}
+
+// Reads not started yet are dropped, the ring thread drains the ones in flight before the buffers go
+Prefetcher::~Prefetcher() {
+    for (auto& file : *files) {
+        int expected = kQueued;
+        file.state.compare_exchange_strong(expected, kFailed, std::memory_order_acq_rel);
+    }
+}
+
+size_t Prefetcher::size() const {
+    return files->size();
+}
+
+std::optional<std::string_view> Prefetcher::text(size_t i) {
+    File& file = (*files)[i];
+    if (!ring) claimAndRead(file);
+    int state = file.state.load(std::memory_order_acquire);
+    while (state == kQueued || state == kReading) {
+        file.state.wait(state, std::memory_order_acquire);
+        state = file.state.load(std::memory_order_acquire);
+    }
+    if (state == kFailed) return std::nullopt;
+    return std::string_view{file.data.get(), file.size};
+}
+
+std::string_view Prefetcher::backend() const {
+    return ring ? "io_uring" : "pread";
+}
+
+} // namespace aoc
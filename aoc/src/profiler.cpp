@@ -0,0 +1,220 @@
+#include <aoc/profiler.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string_view>
+#include <vector>
+
+#ifdef __linux__
+#include <aoc/input.hpp>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <link.h>
+#include <sys/time.h>
+#include <thread>
+#include <unordered_map>
+#endif
+
+namespace aoc
+{
+
+// Stacks recorded by the signal handler, which may neither allocate nor lock: a fixed slot of kMaxFrames return
+// addresses per sample, innermost first, allocated up front but only touched as the slots fill
+struct Profiler::Buffer {
+    static constexpr size_t kMaxFrames = 64;
+    static constexpr size_t kCapacity = size_t{1} << 17;
+
+    std::unique_ptr<void*[]> frames = std::make_unique_for_overwrite<void*[]>(kCapacity * kMaxFrames);
+    std::unique_ptr<int[]> depths = std::make_unique_for_overwrite<int[]>(kCapacity);
+    std::atomic<size_t> next{};
+
+    size_t size() const { return std::min(next.load(), kCapacity); }
+};
+
+#ifdef __linux__
+namespace
+{
+
+std::atomic<Profiler::Buffer*> activeBuffer{};
+std::atomic<int> runningHandlers{};
+struct sigaction previousAction{};
+
+// backtrace() unwinds through the signal frame with the .eh_frame tables, so no frame pointers are needed
+void onProfileSignal(int /*signal*/) {
+    const int savedErrno = errno;
+    runningHandlers.fetch_add(1);
+    if (auto* buffer = activeBuffer.load()) {
+        const size_t i = buffer->next.fetch_add(1, std::memory_order_relaxed);
+        if (i < Profiler::Buffer::kCapacity) {
+            void** frames = buffer->frames.get() + i * Profiler::Buffer::kMaxFrames;
+            buffer->depths[i] = ::backtrace(frames, static_cast<int>(Profiler::Buffer::kMaxFrames));
+        }
+    }
+    runningHandlers.fetch_sub(1);
+    errno = savedErrno;
+}
+
+std::string demangle(const char* name) {
+    int status{};
+    char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    std::string res = status == 0 && demangled ? demangled : name;
+    std::free(demangled);
+    // Separates the frames of a folded stack
+    std::ranges::replace(res, ';', ':');
+    return res;
+}
+
+// Names of functions by address: those of the executable from its ELF symbol table, which dladdr() only sees when it
+// is linked with -rdynamic, those of shared libraries from dladdr()
+class Symbolizer {
+public:
+    Symbolizer() : executable{"/proc/self/exe"} {
+        // The executable is the first object listed, its load bias is what moves a position independent one
+        ::dl_iterate_phdr(
+            [](dl_phdr_info* info, size_t, void* bias) {
+                *static_cast<uintptr_t*>(bias) = info->dlpi_addr;
+                return 1;
+            },
+            &loadBias);
+        readSymbols();
+    }
+
+    // False when the executable was stripped, then only functions of shared libraries have names
+    bool hasSymbols() const { return !symbols.empty(); }
+
+    const std::string& name(uintptr_t address) {
+        auto [it, inserted] = names.try_emplace(address);
+        if (inserted) it->second = lookup(address);
+        return it->second;
+    }
+
+private:
+    struct Symbol {
+        uintptr_t start;
+        uintptr_t end;
+        const char* name;
+    };
+
+    template <class T>
+    const T* at(size_t offset, size_t count = 1) const {
+        const auto text = executable.text();
+        if (offset > text.size() || count > (text.size() - offset) / sizeof(T)) return nullptr;
+        return reinterpret_cast<const T*>(text.data() + offset);
+    }
+
+    void readSymbols() {
+        const auto* header = at<ElfW(Ehdr)>(0);
+        if (!header || std::memcmp(header->e_ident, ELFMAG, SELFMAG) != 0) return;
+        const auto* sections = at<ElfW(Shdr)>(header->e_shoff, header->e_shnum);
+        if (!sections) return;
+        for (size_t i = 0; i < header->e_shnum; ++i) {
+            if (sections[i].sh_type != SHT_SYMTAB || sections[i].sh_link >= header->e_shnum) continue;
+            const auto& strings = sections[sections[i].sh_link];
+            const size_t count = sections[i].sh_size / sizeof(ElfW(Sym));
+            const auto* entries = at<ElfW(Sym)>(sections[i].sh_offset, count);
+            const auto* names = at<char>(strings.sh_offset, strings.sh_size);
+            if (!entries || !names) continue;
+            for (size_t j = 0; j < count; ++j) {
+                const auto& entry = entries[j];
+                if (ELF64_ST_TYPE(entry.st_info) != STT_FUNC || entry.st_value == 0) continue;
+                if (entry.st_name >= strings.sh_size) continue;
+                const uintptr_t start = loadBias + entry.st_value;
+                symbols.push_back({start, start + std::max<uintptr_t>(entry.st_size, 1), names + entry.st_name});
+            }
+        }
+        std::ranges::sort(symbols, {}, &Symbol::start);
+    }
+
+    std::string lookup(uintptr_t address) const {
+        const auto it = std::ranges::upper_bound(symbols, address, {}, &Symbol::start);
+        if (it != begin(symbols) && address < std::prev(it)->end) return demangle(std::prev(it)->name);
+        Dl_info info{};
+        if (::dladdr(reinterpret_cast<void*>(address), &info) != 0) {
+            if (info.dli_sname) return demangle(info.dli_sname);
+            if (info.dli_fname) {
+                const std::string_view path = info.dli_fname;
+                return fmt::format("[{}]", path.substr(path.rfind('/') + 1));
+            }
+        }
+        return fmt::format("0x{:x}", address);
+    }
+
+    MappedFile executable;
+    uintptr_t loadBias{};
+    std::vector<Symbol> symbols;
+    std::unordered_map<uintptr_t, std::string> names;
+};
+
+} // namespace
+#endif
+
+Profiler::Profiler(std::string filename, int frequency) : filename{std::move(filename)} {
+    if (this->filename.empty()) return;
+#ifdef __linux__
+    if (!std::ofstream{this->filename}) {
+        fmt::print("Cannot open '{}'\n", this->filename);
+        return;
+    }
+    // The first call loads the unwinder, which must not happen in the signal handler
+    void* frame{};
+    ::backtrace(&frame, 1);
+    buffer = std::make_unique<Buffer>();
+    activeBuffer.store(buffer.get());
+    struct sigaction action{};
+    action.sa_handler = onProfileSignal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    ::sigaction(SIGPROF, &action, &previousAction);
+    const suseconds_t interval = std::max(1, 1'000'000 / std::max(frequency, 1));
+    const itimerval timer{{0, interval}, {0, interval}};
+    ::setitimer(ITIMER_PROF, &timer, nullptr);
+#else
+    static_cast<void>(frequency);
+    fmt::print("Profiling is only supported on Linux\n");
+#endif
+}
+
+Profiler::~Profiler() {
+    if (!buffer) return;
+#ifdef __linux__
+    const itimerval stopped{};
+    ::setitimer(ITIMER_PROF, &stopped, nullptr);
+    activeBuffer.store(nullptr);
+    // A signal delivered just before the timer stopped may still be writing its sample
+    while (runningHandlers.load() != 0) std::this_thread::yield();
+    ::sigaction(SIGPROF, &previousAction, nullptr);
+
+    // The first two frames are the handler and the signal trampoline, the third is where the thread was interrupted.
+    // Further ones are return addresses, one byte back is still inside the call.
+    constexpr int kSkippedFrames = 2;
+    Symbolizer symbolizer;
+    std::map<std::string, size_t> stacks;
+    for (size_t i = 0; i < buffer->size(); ++i) {
+        void* const* frames = buffer->frames.get() + i * Buffer::kMaxFrames;
+        std::string stack;
+        for (int j = buffer->depths[i]; j-- > kSkippedFrames;) {
+            const auto address = reinterpret_cast<uintptr_t>(frames[j]) - (j > kSkippedFrames ? 1 : 0);
+            if (!stack.empty()) stack += ';';
+            stack += symbolizer.name(address);
+        }
+        if (!stack.empty()) ++stacks[stack];
+    }
+    std::ofstream out{filename};
+    for (const auto& [stack, count] : stacks) out << stack << ' ' << count << '\n';
+    if (buffer->next > Buffer::kCapacity)
+        fmt::print("Profile buffer full, {} samples dropped\n", buffer->next - Buffer::kCapacity);
+    if (!symbolizer.hasSymbols())
+        fmt::print("The executable has no symbol table, configure with -DAOC_KEEP_SYMBOLS=ON to name its functions\n");
+#endif
+}
+
+} // namespace aoc
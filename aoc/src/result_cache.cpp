@@ -0,0 +1,81 @@
+#include <aoc/result_cache.hpp>
+#include <aoc/hash.hpp>
+#include <aoc/history.hpp>
+#include <aoc/input.hpp>
+#include <fmt/format.h>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <system_error>
+
+namespace aoc
+{
+
+ResultCache::ResultCache(std::string_view directory, std::string_view dayName, std::string_view input)
+: inputHash{hashBytes(input)} {
+    const size_t key = hashValues(inputHash, hashBytes(buildId()));
+    filename = (std::filesystem::path{directory} / fmt::format("{}-{:016x}.txt", dayName, key)).string();
+}
+
+// Lines "build ID", "input HASH", "part1 ANSWER" and "part2 ANSWER", the last one only with a part 2
+std::optional<ResultCache::Answers> ResultCache::load() const {
+    std::ifstream in{filename, std::ios::binary};
+    if (!in) return std::nullopt;
+    std::optional<std::string> build, inputLine, part1, part2;
+    std::string line;
+    while (std::getline(in, line)) {
+        const auto space = line.find(' ');
+        if (space == std::string::npos) return std::nullopt;
+        const std::string_view name = std::string_view{line}.substr(0, space);
+        std::string value = line.substr(space + 1);
+        if (name == "build")
+            build = std::move(value);
+        else if (name == "input")
+            inputLine = std::move(value);
+        else if (name == "part1")
+            part1 = std::move(value);
+        else if (name == "part2")
+            part2 = std::move(value);
+    }
+    if (build != buildId() || inputLine != fmt::format("{:016x}", inputHash) || !part1) return std::nullopt;
+    return Answers{std::move(*part1), std::move(part2)};
+}
+
+// Written next to the entry under a name of its own and renamed over it, so that a concurrent run neither reads half
+// an entry nor writes into the same temporary file
+bool ResultCache::store(const Answers& answers) const {
+    auto isLine = [](std::string_view answer) { return answer.find_first_of("\r\n") == std::string_view::npos; };
+    if (!isLine(answers.part1) || (answers.part2 && !isLine(*answers.part2))) return false;
+    const std::filesystem::path path{filename};
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    static std::atomic<uint64_t> storeCount{};
+    const uint64_t suffix = hashValues(std::random_device{}(), std::random_device{}(), storeCount++);
+    const std::filesystem::path temporary = fmt::format("{}.{:016x}.tmp", path.string(), suffix);
+    bool written{};
+    {
+        std::ofstream out{temporary, std::ios::binary | std::ios::trunc};
+        out << fmt::format("build {}\ninput {:016x}\npart1 {}\n", buildId(), inputHash, answers.part1);
+        if (answers.part2) out << "part2 " << *answers.part2 << "\n";
+        written = static_cast<bool>(out.flush());
+    }
+    if (written) std::filesystem::rename(temporary, path, ec);
+    if (written && !ec) return true;
+    std::filesystem::remove(temporary, ec);
+    return false;
+}
+
+std::string_view buildId() {
+    static const std::string id = [] {
+#ifdef __linux__
+        if (const MappedFile executable{"/proc/self/exe"})
+            return fmt::format("exe-{:016x}", hashBytes(executable.text()));
+#endif
+        return fmt::format("{}.{}", buildCommit(), buildPreset());
+    }();
+    return id;
+}
+
+} // namespace aoc
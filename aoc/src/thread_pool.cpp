@@ -0,0 +1,144 @@
+#include <aoc/thread_pool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace aoc
+{
+
+namespace
+{
+
+thread_local const ThreadPool* currentPool{};
+thread_local size_t currentIndex{};
+
+// Not set: defaultSize()
+constexpr size_t kUnsetSize = SIZE_MAX;
+std::atomic<size_t> sharedSize{kUnsetSize};
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    for (size_t i = 0; i <= threadCount; ++i) queues.push_back(std::make_unique<Queue>());
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i)
+        workers.emplace_back([this, i](std::stop_token stopToken) { workerLoop(i, stopToken); });
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    for (auto& worker : workers) worker.request_stop();
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool{sharedSize != kUnsetSize ? sharedSize.load() : defaultSize()};
+    return pool;
+}
+
+void ThreadPool::setSharedSize(size_t threadCount) {
+    sharedSize = threadCount;
+}
+
+size_t ThreadPool::workerIndex() const {
+    return currentPool == this ? currentIndex : size();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    if (workers.empty()) {
+        task();
+        return;
+    }
+    // Counted before it is queued, so that a worker taking it right away never brings the count below zero
+    {
+        std::lock_guard lock{mutex};
+        ++queued;
+    }
+    Queue& queue = *queues[workerIndex()];
+    {
+        std::lock_guard lock{queue.mutex};
+        queue.tasks.push_back(std::move(task));
+    }
+    hasWork.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock lock{mutex};
+    idle.wait(lock, [this] { return queued == 0 && running == 0; });
+}
+
+bool ThreadPool::runPendingTask(size_t index) {
+    std::function<void()> task;
+    for (size_t k = 0; k < queues.size() && !task; ++k) {
+        Queue& queue = *queues[(index + k) % queues.size()];
+        std::lock_guard lock{queue.mutex};
+        if (queue.tasks.empty()) continue;
+        // Its own newest task is the most likely to be in cache, the oldest of another worker the largest left
+        if (k == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        std::lock_guard countLock{mutex};
+        --queued;
+        ++running;
+    }
+    if (!task) return false;
+    task();
+    std::lock_guard lock{mutex};
+    --running;
+    if (queued == 0 && running == 0) idle.notify_all();
+    return true;
+}
+
+void ThreadPool::forEachChunk(size_t count, size_t chunks,
+                              const std::function<void(size_t, size_t, size_t)>& chunkFn) {
+    if (chunks <= 1) {
+        if (count > 0) chunkFn(0, 0, count);
+        return;
+    }
+    // Shared with the helper tasks, some may only start after the loop returned: they find no chunk left and never
+    // touch `chunkFn`
+    struct Loop {
+        std::atomic<size_t> next{};
+        std::atomic<size_t> done{};
+        size_t count{};
+        size_t chunks{};
+        const std::function<void(size_t, size_t, size_t)>* chunkFn{};
+
+        void runChunks() {
+            for (size_t chunk; (chunk = next.fetch_add(1)) < chunks;) {
+                (*chunkFn)(chunk, chunk * count / chunks, (chunk + 1) * count / chunks);
+                done.fetch_add(1, std::memory_order_release);
+                done.notify_all();
+            }
+        }
+    };
+    const auto loop = std::make_shared<Loop>();
+    loop->count = count;
+    loop->chunks = chunks;
+    loop->chunkFn = &chunkFn;
+    for (size_t i = 0, helpers = std::min(size(), chunks - 1); i < helpers; ++i) submit([loop] { loop->runChunks(); });
+    loop->runChunks();
+
+    // Chunks taken by others may still be running. A worker runs other tasks meanwhile, the chunks it waits for may be
+    // waiting on them. Any other thread only runs chunks of its own loop: all of them share the last PerWorker slot.
+    const size_t index = workerIndex();
+    for (size_t done; (done = loop->done.load(std::memory_order_acquire)) < chunks;) {
+        if (index < size() && runPendingTask(index)) continue;
+        loop->done.wait(done, std::memory_order_acquire);
+    }
+}
+
+void ThreadPool::workerLoop(size_t index, std::stop_token stopToken) {
+    currentPool = this;
+    currentIndex = index;
+    while (true) {
+        if (runPendingTask(index)) continue;
+        std::unique_lock lock{mutex};
+        if (!hasWork.wait(lock, stopToken, [this] { return queued > 0; })) return;
+    }
+}
+
+} // namespace aoc
@@ -0,0 +1,116 @@
+#include <aoc/trace.hpp>
+#include <fmt/format.h>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace aoc
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct TraceEvent {
+    std::string_view category;
+    std::string_view name;
+    std::string args;
+    uint32_t thread{};
+    Clock::time_point startTime;
+    Clock::time_point endTime;
+};
+
+std::atomic<bool> sessionActive{};
+std::mutex eventsMutex;
+std::vector<TraceEvent> events;
+Clock::time_point sessionStart;
+
+// Small stable numbers read better than native thread ids on the timeline, the first thread to record is 1
+uint32_t currentThread() {
+    static std::atomic<uint32_t> nextThread{1};
+    thread_local const uint32_t thread = nextThread.fetch_add(1, std::memory_order_relaxed);
+    return thread;
+}
+
+std::string jsonEscape(std::string_view sv) {
+    std::string res;
+    res.reserve(sv.size());
+    for (char ch : sv) {
+        if (ch == '"' || ch == '\\') res += '\\';
+        res += ch;
+    }
+    return res;
+}
+
+double microseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+} // namespace
+
+TraceSession::TraceSession(std::string filename) : filename{std::move(filename)} {
+    if (this->filename.empty()) return;
+    if (!std::ofstream{this->filename}) {
+        fmt::print("Cannot open '{}'\n", this->filename);
+        return;
+    }
+    const std::scoped_lock lock{eventsMutex};
+    events.clear();
+    sessionStart = Clock::now();
+    recording = true;
+    sessionActive = true;
+}
+
+TraceSession::~TraceSession() {
+    if (!recording) return;
+    sessionActive = false;
+    const std::scoped_lock lock{eventsMutex};
+    std::ofstream file{filename};
+    file << R"({"displayTimeUnit": "ms", "traceEvents": [)";
+    const char* separator = "\n";
+    for (const auto& event : events) {
+        file << separator
+             << fmt::format(R"({{"ph": "X", "pid": 1, "tid": {}, "cat": "{}", "name": "{}", "ts": {:.3f}, )"
+                            R"("dur": {:.3f}, "args": {{{}}}}})",
+                            event.thread, jsonEscape(event.category), jsonEscape(event.name),
+                            microseconds(event.startTime - sessionStart), microseconds(event.endTime - event.startTime),
+                            event.args);
+        separator = ",\n";
+    }
+    file << "\n]}\n";
+    events.clear();
+}
+
+bool TraceSession::active() {
+    return sessionActive.load(std::memory_order_relaxed);
+}
+
+TraceSpan::TraceSpan(std::string_view category, std::string_view name)
+: category{category}, name{name}, active{TraceSession::active()} {
+    if (active) startTime = Clock::now();
+}
+
+TraceSpan::TraceSpan(std::string_view category, std::string_view name, std::string_view argName, int64_t argValue)
+: TraceSpan{category, name} {
+    if (active) args = fmt::format(R"("{}": {})", jsonEscape(argName), argValue);
+}
+
+TraceSpan::TraceSpan(std::string_view category, std::string_view name, std::string_view argName,
+                     std::string_view argValue)
+: TraceSpan{category, name} {
+    if (active) args = fmt::format(R"("{}": "{}")", jsonEscape(argName), jsonEscape(argValue));
+}
+
+TraceSpan::~TraceSpan() {
+    if (!active) return;
+    const auto endTime = Clock::now();
+    const uint32_t thread = currentThread();
+    const std::scoped_lock lock{eventsMutex};
+    // A span still open when its session ended is dropped
+    if (!TraceSession::active()) return;
+    events.push_back({category, name, std::move(args), thread, startTime, endTime});
+}
+
+} // namespace aoc
@@ -0,0 +1,42 @@
+# Writes the commit and compiler preset that benchmark history records are keyed by.
+#
+#   cmake -DAOC_SOURCE_DIR=<repo> -DAOC_PRESET=<linux.gcc> -DAOC_OUTPUT=<build_info.cpp> -P build_info.cmake
+#
+# Runs on every build. file(CONFIGURE) only rewrites the output when one of them changed, so nothing relinks otherwise.
+cmake_minimum_required(VERSION 3.23)
+
+set(commit "unknown")
+execute_process(COMMAND git rev-parse --short=12 HEAD
+                WORKING_DIRECTORY "${AOC_SOURCE_DIR}"
+                RESULT_VARIABLE rc
+                OUTPUT_VARIABLE head
+                OUTPUT_STRIP_TRAILING_WHITESPACE
+                ERROR_QUIET)
+if(rc EQUAL 0)
+  set(commit "${head}")
+  execute_process(COMMAND git status --porcelain --untracked-files=no
+                  WORKING_DIRECTORY "${AOC_SOURCE_DIR}"
+                  OUTPUT_VARIABLE changes
+                  ERROR_QUIET)
+  if(changes)
+    string(APPEND commit "-dirty")
+  endif()
+endif()
+
+file(CONFIGURE OUTPUT "${AOC_OUTPUT}" CONTENT [[
+// Generated by cmake/build_info.cmake
+#include <aoc/history.hpp>
+
+namespace aoc
+{
+
+std::string_view buildCommit() {
+    return "@commit@";
+}
+
+std::string_view buildPreset() {
+    return "@AOC_PRESET@";
+}
+
+} // namespace aoc
+]] @ONLY)
@@ -1,8 +1,12 @@
 include(${CMAKE_CURRENT_SOURCE_DIR}/cmake/static_analysis.cmake)
 include(${CMAKE_CURRENT_SOURCE_DIR}/cmake/sanitize.cmake)
 
+option(AOC_KEEP_SYMBOLS "Keep the symbol table of Release binaries, which --profile names functions from" OFF)
+
 function(target_strip_symbols target_name)
-  if(CMAKE_CXX_COMPILER_ID STREQUAL "MSVC")
+  if(AOC_KEEP_SYMBOLS)
+    # stripping would leave --profile with addresses only
+  elseif(CMAKE_CXX_COMPILER_ID STREQUAL "MSVC")
     # cl doesn't need stripping
   elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang" AND CMAKE_CXX_SIMULATE_ID MATCHES "MSVC")
     # clang-cl doesn't need stripping
@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day1
+{
+const aoc::Day& getDay();
+} // namespace day1
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day1::getDay(), argc, argv);
+}
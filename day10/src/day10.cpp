@@ -1,30 +1,31 @@
+#include <aoc/day.hpp>
+#include <aoc/grid.hpp>
+#include <aoc/input.hpp>
 #include <fmt/format.h>
 #include <fmt/color.h>
 #include <fmt/ranges.h>
 #include <fmt/ostream.h>
 #include <vector>
-#include <sstream>
-#include <fstream>
+#include <string>
 #include <numeric>
 #include <algorithm>
 #include <ranges>
 #include <queue>
 #include <stack>
-#include <tuple>
-#include <chrono>
-namespace cron = std::chrono;
-using namespace std::chrono_literals;
+#include <utility>
 namespace ranges = std::ranges;
 namespace views = std::views;
 
+namespace day10
+{
+
 static constexpr std::string_view kInputFilename = "day10.txt";
 
-using Input = std::vector<std::string>;
+using Input = aoc::Grid<char>;
 
-Input parseInput(std::istream& in) {
-    Input res;
-    for (std::string line; std::getline(in, line);) res.push_back(line);
-    return res;
+// One cell of '.' around the tiles, so following a pipe never needs a bounds check
+Input parseInput(std::string_view text) {
+    return Input::fromLines(aoc::splitLines(text), 1, '.');
 }
 
 enum class Dir { Left, Right, Top, Bottom };
@@ -42,108 +43,105 @@ bool isConnectorR(char rig) {
     return rig == '-' || rig == 'J' || rig == '7';
 };
 
-std::pair<size_t, size_t> findStart(const Input& input) {
-    for (size_t i = 0; i < input.size(); ++i)
-        for (size_t j = 0; j < input[0].size(); ++j)
-            if (input[i][j] == 'S') return {i, j};
-    return {-1, -1};
+size_t findStart(const Input& input) {
+    for (int i = 0; i < input.rows(); ++i)
+        for (int j = 0; j < input.cols(); ++j)
+            if (input(i, j) == 'S') return input.index(i, j);
+    return 0;
 }
 
 int part1(const Input& input) {
-    const size_t rows = input.size();
-    const size_t cols = input[0].size();
-    auto [sr, sc] = findStart(input);
-    std::queue<std::tuple<size_t, size_t, int>> q;
-    std::vector<std::vector<bool>> visited(rows, std::vector<bool>(cols));
-    q.emplace(sr, sc, 0);
-    visited[sr][sc] = true;
-    auto enqueueUnvisitedNeighbor = [&](size_t r, size_t c, int dist, Dir from) {
-        if (!(r < rows && c < cols && input[r][c] != '.' && !visited[r][c])) return;
-        if (from == Dir::Left && !isConnectorR(input[r][c])) return;
-        if (from == Dir::Right && !isConnectorL(input[r][c])) return;
-        if (from == Dir::Top && !isConnectorB(input[r][c])) return;
-        if (from == Dir::Bottom && !isConnectorT(input[r][c])) return;
-        q.emplace(r, c, dist);
-        visited[r][c] = true;
+    const ptrdiff_t stride = input.stride();
+    const size_t start = findStart(input);
+    std::queue<std::pair<size_t, int>> q;
+    auto visited = aoc::Grid<uint8_t>::shapedLike(input);
+    q.emplace(start, 0);
+    visited[start] = 1;
+    auto enqueueUnvisitedNeighbor = [&](size_t cell, int dist, Dir from) {
+        if (input[cell] == '.' || visited[cell]) return;
+        if (from == Dir::Left && !isConnectorR(input[cell])) return;
+        if (from == Dir::Right && !isConnectorL(input[cell])) return;
+        if (from == Dir::Top && !isConnectorB(input[cell])) return;
+        if (from == Dir::Bottom && !isConnectorT(input[cell])) return;
+        q.emplace(cell, dist);
+        visited[cell] = 1;
     };
     int res{};
     while (!q.empty()) {
-        auto [r, c, d] = q.front();
+        auto [cell, d] = q.front();
         q.pop();
         res = std::max(res, d);
-        const char rep = input[r][c];
+        const char rep = input[cell];
         if (rep == 'S') {
-            enqueueUnvisitedNeighbor(r - 1, c, d + 1, Dir::Bottom);
-            enqueueUnvisitedNeighbor(r + 1, c, d + 1, Dir::Top);
-            enqueueUnvisitedNeighbor(r, c - 1, d + 1, Dir::Right);
-            enqueueUnvisitedNeighbor(r, c + 1, d + 1, Dir::Left);
+            enqueueUnvisitedNeighbor(cell - stride, d + 1, Dir::Bottom);
+            enqueueUnvisitedNeighbor(cell + stride, d + 1, Dir::Top);
+            enqueueUnvisitedNeighbor(cell - 1, d + 1, Dir::Right);
+            enqueueUnvisitedNeighbor(cell + 1, d + 1, Dir::Left);
         } else if (rep == '|') {
-            enqueueUnvisitedNeighbor(r - 1, c, d + 1, Dir::Bottom);
-            enqueueUnvisitedNeighbor(r + 1, c, d + 1, Dir::Top);
+            enqueueUnvisitedNeighbor(cell - stride, d + 1, Dir::Bottom);
+            enqueueUnvisitedNeighbor(cell + stride, d + 1, Dir::Top);
         } else if (rep == '-') {
-            enqueueUnvisitedNeighbor(r, c - 1, d + 1, Dir::Right);
-            enqueueUnvisitedNeighbor(r, c + 1, d + 1, Dir::Left);
+            enqueueUnvisitedNeighbor(cell - 1, d + 1, Dir::Right);
+            enqueueUnvisitedNeighbor(cell + 1, d + 1, Dir::Left);
         } else if (rep == 'L') {
-            enqueueUnvisitedNeighbor(r - 1, c, d + 1, Dir::Bottom);
-            enqueueUnvisitedNeighbor(r, c + 1, d + 1, Dir::Left);
+            enqueueUnvisitedNeighbor(cell - stride, d + 1, Dir::Bottom);
+            enqueueUnvisitedNeighbor(cell + 1, d + 1, Dir::Left);
         } else if (rep == 'J') {
-            enqueueUnvisitedNeighbor(r - 1, c, d + 1, Dir::Bottom);
-            enqueueUnvisitedNeighbor(r, c - 1, d + 1, Dir::Right);
+            enqueueUnvisitedNeighbor(cell - stride, d + 1, Dir::Bottom);
+            enqueueUnvisitedNeighbor(cell - 1, d + 1, Dir::Right);
         } else if (rep == '7') {
-            enqueueUnvisitedNeighbor(r + 1, c, d + 1, Dir::Top);
-            enqueueUnvisitedNeighbor(r, c - 1, d + 1, Dir::Right);
+            enqueueUnvisitedNeighbor(cell + stride, d + 1, Dir::Top);
+            enqueueUnvisitedNeighbor(cell - 1, d + 1, Dir::Right);
         } else if (rep == 'F') {
-            enqueueUnvisitedNeighbor(r + 1, c, d + 1, Dir::Top);
-            enqueueUnvisitedNeighbor(r, c + 1, d + 1, Dir::Left);
+            enqueueUnvisitedNeighbor(cell + stride, d + 1, Dir::Top);
+            enqueueUnvisitedNeighbor(cell + 1, d + 1, Dir::Left);
         }
     }
     return res;
 }
 
-std::pair<size_t, size_t> recoverStart(Input& input) {
-    auto [r, c] = findStart(input);
+size_t recoverStart(Input& input) {
+    const ptrdiff_t stride = input.stride();
+    const size_t start = findStart(input);
     unsigned kind{}; // 0bTBLR
-    if (r - 1 < input.size() && isConnectorT(input[r - 1][c])) kind |= 0b1000;
-    if (r + 1 < input.size() && isConnectorB(input[r + 1][c])) kind |= 0b0100;
-    if (c - 1 < input[0].size() && isConnectorL(input[r][c - 1])) kind |= 0b0010;
-    if (c + 1 < input[0].size() && isConnectorR(input[r][c + 1])) kind |= 0b0001;
-    if (kind == 0b1100) input[r][c] = '|';
-    if (kind == 0b1010) input[r][c] = 'J';
-    if (kind == 0b1001) input[r][c] = 'L';
-    if (kind == 0b0110) input[r][c] = '7';
-    if (kind == 0b0101) input[r][c] = 'F';
-    if (kind == 0b0011) input[r][c] = '-';
-    return {r, c};
+    if (isConnectorT(input[start - stride])) kind |= 0b1000;
+    if (isConnectorB(input[start + stride])) kind |= 0b0100;
+    if (isConnectorL(input[start - 1])) kind |= 0b0010;
+    if (isConnectorR(input[start + 1])) kind |= 0b0001;
+    if (kind == 0b1100) input[start] = '|';
+    if (kind == 0b1010) input[start] = 'J';
+    if (kind == 0b1001) input[start] = 'L';
+    if (kind == 0b0110) input[start] = '7';
+    if (kind == 0b0101) input[start] = 'F';
+    if (kind == 0b0011) input[start] = '-';
+    return start;
 }
 
-std::tuple<size_t, size_t, Input> getExpandedInput(Input& input) {
-    auto [sr, sc] = recoverStart(input);
-    Input res;
-    res.push_back(std::string(input[0].size() * 2 + 1, ' '));
-    for (const auto& line : input) {
-        std::string newLine{" "};
-        for (char ch : line) newLine += ch, newLine += ' ';
-        res.push_back(std::move(newLine));
-        res.push_back(std::string(input[0].size() * 2 + 1, ' '));
-    }
-    for (size_t i = 1; i < res.size(); i += 2)
-        for (size_t j = 1; j < res[i].size(); j += 2) {
-            if (isConnectorL(res[i][j]) && j + 2 < res[0].size() && isConnectorR(res[i][j + 2])) res[i][j + 1] = '-';
-            if (isConnectorT(res[i][j]) && i + 2 < res.size() && isConnectorB(res[i + 2][j])) res[i + 1][j] = '|';
+// Tiles spread out to odd rows and columns with the gaps in between bridged, so the outside can flow between pipes
+std::pair<size_t, aoc::Grid<char>> getExpandedInput(Input& input) {
+    const auto [sr, sc] = input.position(recoverStart(input));
+    aoc::Grid<char> res(input.rows() * 2 + 1, input.cols() * 2 + 1, ' ', 1, ' ');
+    for (int i = 0; i < input.rows(); ++i)
+        for (int j = 0; j < input.cols(); ++j) res(1 + 2 * i, 1 + 2 * j) = input(i, j);
+    for (int i = 1; i < res.rows(); i += 2)
+        for (int j = 1; j < res.cols(); j += 2) {
+            if (isConnectorL(res(i, j)) && isConnectorR(res(i, j + 2))) res(i, j + 1) = '-';
+            if (isConnectorT(res(i, j)) && isConnectorB(res(i + 2, j))) res(i + 1, j) = '|';
         }
-    return {sr, sc, res};
+    return {res.index(1 + 2 * sr, 1 + 2 * sc), std::move(res)};
 }
 
-void pprint(const Input& input, size_t sr, size_t sc, const std::vector<std::vector<bool>>& isBorder,
-            const std::vector<std::vector<bool>>& isOutside) {
-    for (size_t i = 0; auto& line : input) {
-        for (size_t j = 0; char ch : line) {
-            const auto color = i == sr && j == sc ? fg(fmt::color::blue)
-                               : isBorder[i][j]   ? fg(fmt::color::pale_green)
-                               : isOutside[i][j]  ? fg(fmt::color::pale_golden_rod)
-                               : i % 2 && j % 2   ? fg(fmt::color::white)
-                                                  : fg(fmt::color::gray);
-            if (isOutside[i][j])
+void pprint(const aoc::Grid<char>& input, size_t start, const aoc::Grid<uint8_t>& isBorder,
+            const aoc::Grid<uint8_t>& isOutside) {
+    for (int i = 0; i < input.rows(); ++i) {
+        for (int j = 0; j < input.cols(); ++j) {
+            const char ch = input(i, j);
+            const auto color = input.index(i, j) == start ? fg(fmt::color::blue)
+                               : isBorder(i, j)           ? fg(fmt::color::pale_green)
+                               : isOutside(i, j)          ? fg(fmt::color::pale_golden_rod)
+                               : i % 2 && j % 2           ? fg(fmt::color::white)
+                                                          : fg(fmt::color::gray);
+            if (isOutside(i, j))
                 fmt::print(color, "O");
             else if (ch == '|')
                 fmt::print(color, "│");
@@ -159,91 +157,64 @@ void pprint(const Input& input, size_t sr, size_t sc, const std::vector<std::vec
                 fmt::print(color, "┘");
             else
                 fmt::print(color, "{}", ch);
-            ++j;
         }
         fmt::print("\n");
-        ++i;
     }
 }
 
-int part2(Input input, bool debug = false) {
-    auto [sr, sc, expInp] = getExpandedInput(input);
-    auto dfs = [](size_t sr, size_t sc, auto& visited, auto&& validNeighbor, auto&& visit) {
-        std::stack<std::pair<size_t, size_t>> st;
-        auto push = [&](size_t r, size_t c) {
-            if (visited[r][c] || !validNeighbor(r, c)) return;
-            st.emplace(r, c);
-            visited[r][c] = true;
+int part2(const Input& input, bool debug = false) {
+    Input tiles = input;
+    auto [start, expInp] = getExpandedInput(tiles);
+    const ptrdiff_t stride = expInp.stride();
+    auto dfs = [](size_t start, auto& visited, auto&& validNeighbor, auto&& visit) {
+        std::stack<size_t> st;
+        auto push = [&](size_t cell) {
+            if (visited[cell] || !validNeighbor(cell)) return;
+            st.push(cell);
+            visited[cell] = 1;
         };
-        for (push(sr, sc); !st.empty();) {
-            auto [r, c] = st.top();
+        for (push(start); !st.empty();) {
+            const size_t cell = st.top();
             st.pop();
-            visit(r, c, push);
+            visit(cell, push);
         }
     };
     // Border
-    std::vector<std::vector<bool>> isBorder(expInp.size(), std::vector<bool>(expInp[0].size()));
+    auto isBorder = aoc::Grid<uint8_t>::shapedLike(expInp);
     dfs(
-        sr = 1 + 2 * sr, sc = 1 + 2 * sc, isBorder, [](size_t, size_t) { return true; },
-        [&](size_t r, size_t c, auto&& push) {
-            if (expInp[r][c] == '|') push(r - 1, c), push(r + 1, c);
-            if (expInp[r][c] == '-') push(r, c - 1), push(r, c + 1);
-            if (expInp[r][c] == 'F') push(r + 1, c), push(r, c + 1);
-            if (expInp[r][c] == '7') push(r + 1, c), push(r, c - 1);
-            if (expInp[r][c] == 'L') push(r - 1, c), push(r, c + 1);
-            if (expInp[r][c] == 'J') push(r - 1, c), push(r, c - 1);
+        start, isBorder, [](size_t) { return true; },
+        [&](size_t cell, auto&& push) {
+            if (expInp[cell] == '|') push(cell - stride), push(cell + stride);
+            if (expInp[cell] == '-') push(cell - 1), push(cell + 1);
+            if (expInp[cell] == 'F') push(cell + stride), push(cell + 1);
+            if (expInp[cell] == '7') push(cell + stride), push(cell - 1);
+            if (expInp[cell] == 'L') push(cell - stride), push(cell + 1);
+            if (expInp[cell] == 'J') push(cell - stride), push(cell - 1);
         });
-    // O
-    std::vector<std::vector<bool>> isOutside(expInp.size(), std::vector<bool>(expInp[0].size()));
+    // O, the padding counts as already visited so the flood fill stays inside
+    auto isOutside = aoc::Grid<uint8_t>::shapedLike(expInp, 0, 1);
     dfs(
-        0, 0, isOutside, [&](size_t r, size_t c) { return !isBorder[r][c]; },
-        [&](size_t r, size_t c, auto&& push) {
-            if (r - 1 < expInp.size()) push(r - 1, c);
-            if (r + 1 < expInp.size()) push(r + 1, c);
-            if (c - 1 < expInp[0].size()) push(r, c - 1);
-            if (c + 1 < expInp[0].size()) push(r, c + 1);
+        expInp.index(0, 0), isOutside, [&](size_t cell) { return !isBorder[cell]; },
+        [&](size_t cell, auto&& push) {
+            for (ptrdiff_t offset : expInp.offsets4()) push(cell + offset);
         });
     int res{};
-    for (size_t i = 1; i < expInp.size(); i += 2)
-        for (size_t j = 1; j < expInp[0].size(); j += 2)
-            if (!isBorder[i][j] && !isOutside[i][j]) ++res;
-    if (debug) pprint(expInp, sr, sc, isBorder, isOutside);
+    for (int i = 1; i < expInp.rows(); i += 2)
+        for (int j = 1; j < expInp.cols(); j += 2)
+            if (!isBorder(i, j) && !isOutside(i, j)) ++res;
+    if (debug) pprint(expInp, start, isBorder, isOutside);
     return res;
 }
 
-std::pair<bool, bool> test() {
-    auto testPart1 = [](std::istream& is, int correctAnswer) {
-        const auto input = parseInput(is);
-        const int answer = part1(input);
-        const bool correct = answer == correctAnswer;
-        fmt::print("Part 1: expected {}, got {}\n", correctAnswer,
-                   fmt::styled(answer, fmt::fg(correct ? fmt::color::green : fmt::color::red)));
-        return correct;
-    };
-    constexpr std::pair<std::string_view, int> part1Cases[] = {{R"(
+std::vector<aoc::Sample> samples() {
+    constexpr std::string_view sample1{R"(
 ..F7.
 .FJ|.
 SJ.L7
 |F--J
 LJ...
-)",
-                                                                8}};
-    bool part1Correct = true;
-    for (auto [sv, correctAnswer] : part1Cases) {
-        std::istringstream iss{sv.data()};
-        iss.ignore();
-        part1Correct &= testPart1(iss, correctAnswer);
-    }
-
-    auto testPart2 = [](std::istream& is, int correctAnswer) {
-        const auto input = parseInput(is);
-        const int answer = part2(input, true);
-        const bool correct = answer == correctAnswer;
-        fmt::print("Part 2: expected {}, got {}\n", correctAnswer,
-                   fmt::styled(answer, fmt::fg(correct ? fmt::color::green : fmt::color::red)));
-        return correct;
-    };
-    constexpr std::pair<std::string_view, int> part2Cases[] = {{R"(
+)"};
+    constexpr std::string_view sample2{R"(
 .F----7F7F7F7F-7....
 .|F--7||||||||FJ....
 .||.FJ||||||||L7....
@@ -254,9 +225,8 @@ L--J.L7...LJS7F-7L7.
 .....|FJLJ|FJ|F7|.LJ
 ....FJL-7.||.||||...
 ....L---J.LJ.LJLJ...
-)",
-                                                                8},
-                                                               {R"(
+)"};
+    constexpr std::string_view sample3{R"(
 FF7FSF7F7F7F7F7F---7
 L|LJ||||||||||||F--J
 FL-7LJLJ||||||LJL-77
@@ -267,9 +237,8 @@ L---JF-JLJ.||-FJLJJ7
 7-L-JL7||F7|L7F-7F7|
 L.L7LFJ|||||FJL7||LJ
 L7JLJL-JLJLJL--JLJ.L
-)",
-                                                                10},
-                                                               {R"(
+)"};
+    constexpr std::string_view sample4{R"(
 F-S---7
 |.....|
 |.F-7.|
@@ -277,40 +246,19 @@ F-S---7
 |.L-J.|
 |.....|
 L-----J
-)",
-                                                                25}};
-    bool part2Correct = true;
-    for (auto [sv, correctAnswer] : part2Cases) {
-        std::istringstream iss{sv.data()};
-        iss.ignore();
-        part2Correct &= testPart2(iss, correctAnswer);
-    }
-    return {part1Correct, part2Correct};
-}
-
-int main() {
-    auto [test1, test2] = test();
-    if (!test1) return 1;
-    auto in = std::ifstream(kInputFilename.data());
-    if (!in) {
-        fmt::print("Cannot open '{}'\n", kInputFilename);
-        return -1;
-    }
-    const auto input = parseInput(in);
-
-    auto getTimeColor = [](const auto& elapsed) {
-        return elapsed < 100ms ? fmt::color::light_green : elapsed < 1s ? fmt::color::orange : fmt::color::orange_red;
+)"};
+    return {
+        aoc::makeSample(1, sample1, 8, parseInput, part1),
+        aoc::makeSample(2, sample2, 8, parseInput, [](const Input& input) { return part2(input, true); }),
+        aoc::makeSample(2, sample3, 10, parseInput, [](const Input& input) { return part2(input, true); }),
+        aoc::makeSample(2, sample4, 25, parseInput, [](const Input& input) { return part2(input, true); }),
     };
-    auto startTime = cron::steady_clock::now();
-    const auto part1Ans = part1(input);
-    cron::duration<double> elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 1: {} in {}\n", fmt::styled(part1Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+}
 
-    if (!test2) return 2;
-    startTime = cron::steady_clock::now();
-    const auto part2Ans = part2(input);
-    elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 2: {} in {}\n", fmt::styled(part2Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+const aoc::Day& getDay() {
+    static const aoc::Day day = aoc::makeDay("day10", kInputFilename, samples(), parseInput, part1,
+                                             [](const Input& input) { return part2(input); });
+    return day;
 }
+
+} // namespace day10
@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day10
+{
+const aoc::Day& getDay();
+} // namespace day10
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day10::getDay(), argc, argv);
+}
@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day11
+{
+const aoc::Day& getDay();
+} // namespace day11
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day11::getDay(), argc, argv);
+}
@@ -1,34 +1,41 @@
+#include <aoc/day.hpp>
+#include <aoc/input.hpp>
+#include <aoc/scanner.hpp>
+#include <aoc/thread_pool.hpp>
 #include <fmt/format.h>
-#include <fmt/color.h>
 #include <fmt/ranges.h>
 #include <vector>
-#include <sstream>
-#include <fstream>
+#include <string>
 #include <numeric>
 #include <algorithm>
 #include <ranges>
 #include <optional>
-#include <chrono>
-namespace cron = std::chrono;
-using namespace std::chrono_literals;
+#include <functional>
 namespace ranges = std::ranges;
 namespace views = std::views;
 
+namespace day12
+{
+
 static constexpr std::string_view kInputFilename = "day12.txt";
 
-using Input = std::vector<std::pair<std::string, std::vector<int>>>;
+using Row = std::pair<std::string, std::vector<int>>;
+using Input = std::vector<Row>;
+
+// "???.### 1,1,3"
+Row parseRow(std::string_view line) {
+    const auto i = line.find(' ');
+    aoc::Scanner iss{line.substr(i + 1)};
+    std::vector<int> counts;
+    int n{};
+    for (char ignore; iss >> n >> ignore;) counts.push_back(n);
+    counts.push_back(n);
+    return {std::string{line.substr(0, i)}, std::move(counts)};
+}
 
-Input parseInput(std::istream& in) {
+Input parseInput(std::string_view text) {
     Input res;
-    for (std::string line; std::getline(in, line);) {
-        const auto i = line.find(' ');
-        std::istringstream iss(line.substr(i + 1));
-        std::vector<int> counts;
-        int n{};
-        for (char ignore; iss >> n >> ignore;) counts.push_back(n);
-        counts.push_back(n);
-        res.emplace_back(line.substr(0, i), std::move(counts));
-    }
+    for (std::string_view line : aoc::splitLines(text)) res.push_back(parseRow(line));
     return res;
 }
 
@@ -50,16 +57,21 @@ bool match(std::string_view sv, const std::vector<int>& counts) {
     return i == sv.npos;
 }
 
-int part1(const Input& input) {
-    return ranges::fold_left(input, 0, [](int sum, const auto& line) {
-        auto& [s, counts] = line;
-        const unsigned slotCount = static_cast<unsigned>(ranges::count(s, '?'));
-        int validCount{};
-        for (unsigned id = (1U << slotCount); id--;) validCount += match(buildStringFromId(s, id), counts);
-        return sum + validCount;
-    });
+// Every assignment of the unknown springs tried
+int countArrangementsBruteForce(const Row& row) {
+    auto& [s, counts] = row;
+    const unsigned slotCount = static_cast<unsigned>(ranges::count(s, '?'));
+    int validCount{};
+    for (unsigned id = (1U << slotCount); id--;) validCount += match(buildStringFromId(s, id), counts);
+    return validCount;
+}
+
+// Exponential in the unknown springs of a row, kept as the reference of part 1
+int part1Reference(const Input& input) {
+    return ranges::fold_left(input, 0, [](int sum, const Row& row) { return sum + countArrangementsBruteForce(row); });
 }
 
+// Arrangements of the springs of `s` matching `counts`, memoized on (length of the current group, position, group)
 struct DynamicProgramming {
     std::string_view s;
     const std::vector<int>& counts;
@@ -88,24 +100,53 @@ struct DynamicProgramming {
     }
 };
 
-int64_t part2(const Input& input) {
-    int64_t res{};
-    for (auto& [s, counts] : input) {
-        std::string newS = s;
-        auto newCounts = counts;
-        for (int i = 4; i--;) {
-            newS += '?';
-            newS += s;
-            newCounts.insert(end(newCounts), begin(counts), end(counts));
-        }
-        DynamicProgramming dp(newS, newCounts);
-        res += dp.solve(0, 0, 0);
+int64_t countArrangements(std::string_view s, const std::vector<int>& counts) {
+    DynamicProgramming dp(s, counts);
+    return dp.solve(0, 0, 0);
+}
+
+int64_t part1(const Input& input) {
+    return ranges::fold_left(input, int64_t{}, [](int64_t sum, const Row& row) {
+        return sum + countArrangements(row.first, row.second);
+    });
+}
+
+// The row and its counts repeated five times
+int64_t countUnfoldedArrangements(const Row& row) {
+    auto& [s, counts] = row;
+    std::string newS = s;
+    auto newCounts = counts;
+    for (int i = 4; i--;) {
+        newS += '?';
+        newS += s;
+        newCounts.insert(end(newCounts), begin(counts), end(counts));
     }
-    return res;
+    return countArrangements(newS, newCounts);
+}
+
+// Rows are independent, they are spread over the shared thread pool
+int64_t part2(const Input& input) {
+    return aoc::parallelReduce(
+        input.size(), int64_t{}, [&](size_t i) { return countUnfoldedArrangements(input[i]); }, std::plus{});
 }
 
-std::pair<bool, bool> test() {
-    std::istringstream iss1{R"(
+// Both sums row by row, for --stream
+struct Fold {
+    int64_t sum1{};
+    int64_t sum2{};
+
+    void add(std::string_view line) {
+        if (line.empty()) return;
+        const Row row = parseRow(line);
+        sum1 += countArrangements(row.first, row.second);
+        sum2 += countUnfoldedArrangements(row);
+    }
+    int64_t part1() const { return sum1; }
+    int64_t part2() const { return sum2; }
+};
+
+std::vector<aoc::Sample> samples() {
+    constexpr std::string_view sample1{R"(
 ???.### 1,1,3
 .??..??...?##. 1,1,3
 ?#?#?#?#?#?#?#? 1,3,1,6
@@ -113,47 +154,17 @@ std::pair<bool, bool> test() {
 ????.######..#####. 1,6,5
 ?###???????? 3,2,1
 )"};
-    iss1.ignore();
-    const auto input1 = parseInput(iss1);
-
-    constexpr int part1CorrectAnswer = 21;
-    const int part1Answer = part1(input1);
-    const bool part1Correct = part1Answer == part1CorrectAnswer;
-    fmt::print("Part 1: expected {}, got {}\n", part1CorrectAnswer,
-               fmt::styled(part1Answer, fmt::fg(part1Correct ? fmt::color::green : fmt::color::red)));
-
-    constexpr int64_t part2CorrectAnswer = 525152;
-    const int64_t part2Answer = part2(input1);
-    const bool part2Correct = part2Answer == part2CorrectAnswer;
-    fmt::print("Part 2: expected {}, got {}\n", part2CorrectAnswer,
-               fmt::styled(part2Answer, fmt::fg(part2Correct ? fmt::color::green : fmt::color::red)));
-
-    return {part1Correct, part2Correct};
+    return {
+        aoc::makeSample(1, sample1, 21, parseInput, part1),
+        aoc::makeSample(2, sample1, 525152, parseInput, part2),
+    };
 }
 
-int main() {
-    auto [test1, test2] = test();
-    if (!test1) return 1;
-    auto in = std::ifstream(kInputFilename.data());
-    if (!in) {
-        fmt::print("Cannot open '{}'\n", kInputFilename);
-        return -1;
-    }
-    const auto input = parseInput(in);
-
-    auto getTimeColor = [](const auto& elapsed) {
-        return elapsed < 100ms ? fmt::color::light_green : elapsed < 1s ? fmt::color::orange : fmt::color::orange_red;
-    };
-    auto startTime = cron::steady_clock::now();
-    const auto part1Ans = part1(input);
-    cron::duration<double> elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 1: {} in {}\n", fmt::styled(part1Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
-
-    if (!test2) return 2;
-    startTime = cron::steady_clock::now();
-    const auto part2Ans = part2(input);
-    elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 2: {} in {}\n", fmt::styled(part2Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+const aoc::Day& getDay() {
+    static const aoc::Day day = aoc::withReference(
+        aoc::withStream<Fold>(aoc::makeDay("day12", kInputFilename, samples(), parseInput, part1, part2)), 1,
+        parseInput, part1Reference);
+    return day;
 }
+
+} // namespace day12
@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day12
+{
+const aoc::Day& getDay();
+} // namespace day12
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day12::getDay(), argc, argv);
+}
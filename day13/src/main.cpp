@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day13
+{
+const aoc::Day& getDay();
+} // namespace day13
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day13::getDay(), argc, argv);
+}
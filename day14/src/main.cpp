@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day14
+{
+const aoc::Day& getDay();
+} // namespace day14
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day14::getDay(), argc, argv);
+}
@@ -1,43 +1,49 @@
+#include <aoc/day.hpp>
+#include <aoc/input.hpp>
+#include <aoc/scanner.hpp>
 #include <fmt/format.h>
-#include <fmt/color.h>
 #include <vector>
-#include <sstream>
-#include <fstream>
 #include <numeric>
 #include <algorithm>
 #include <array>
+#include <string>
 #include <ranges>
-#include <chrono>
-namespace cron = std::chrono;
-using namespace std::chrono_literals;
 namespace ranges = std::ranges;
 namespace views = std::views;
 
+namespace day15
+{
+
 static constexpr std::string_view kInputFilename = "day15.txt";
 
-using Input = std::vector<std::string>;
+using Input = std::vector<std::string_view>;
 
-uint8_t HASH(std::string_view sv, uint8_t val = 0) {
+constexpr uint8_t HASH(std::string_view sv, uint8_t val = 0) {
     for (char c : sv) val = static_cast<uint8_t>((static_cast<unsigned>(val) + c) * 17);
     return val;
 }
 
-Input parseInput(std::istream& in) {
-    std::string line;
-    std::getline(in, line);
-    std::istringstream iss{line};
+constexpr Input parseInput(std::string_view text) {
+    const std::string_view line = text.substr(0, text.find_first_of("\r\n"));
     Input res;
-    for (std::string tok; std::getline(iss, tok, ',');) res.push_back(tok);
+    for (size_t i = 0; i < line.size();) {
+        const size_t comma = std::min(line.find(',', i), line.size());
+        res.push_back(line.substr(i, comma - i));
+        i = comma + 1;
+    }
     return res;
 }
 
-int part1(const Input& input) {
+constexpr int part1(const Input& input) {
     return ranges::fold_left(input, 0, [](int sum, std::string_view sv) { return sum + HASH(sv); });
 }
 
-int part2(const Input& input) {
-    std::array<std::vector<std::pair<std::string_view, int>>, 256> boxes{};
-    for (std::string_view sv : input) {
+// Lens boxes, labelled by views of the input or, when it is streamed, by copies
+template <class Label>
+struct Boxes {
+    std::array<std::vector<std::pair<Label, int>>, 256> boxes{};
+
+    constexpr void apply(std::string_view sv) {
         char op = sv.back() == '-' ? '-' : '=';
         auto label = sv.substr(0, sv.find(op));
         const auto h = HASH(label);
@@ -45,7 +51,7 @@ int part2(const Input& input) {
         if (op == '-') {
             if (it != end(boxes[h])) boxes[h].erase(it);
         } else {
-            const int value = std::stoi(sv.substr(sv.find(op) + 1).data());
+            const int value = aoc::parseInt(sv.substr(sv.find(op) + 1));
             if (it != end(boxes[h])) {
                 it->second = value;
             } else {
@@ -53,62 +59,56 @@ int part2(const Input& input) {
             }
         }
     }
-    int res{};
-    for (int i : views::iota(0, 256)) {
-        if (boxes[i].empty()) continue;
-        for (int slot = 1; auto& p : boxes[i]) {
-            res += (i + 1) * slot * p.second;
-            ++slot;
+
+    constexpr int focusingPower() const {
+        int res{};
+        for (int i : views::iota(0, 256)) {
+            if (boxes[i].empty()) continue;
+            for (int slot = 1; auto& p : boxes[i]) {
+                res += (i + 1) * slot * p.second;
+                ++slot;
+            }
         }
+        return res;
     }
-    return res;
-}
+};
 
-std::pair<bool, bool> test() {
-    std::istringstream iss1{R"(
-rn=1,cm-,qp=3,cm=2,qp-,pc=4,ot=9,ab=5,pc-,pc=6,ot=7
-)"};
-    iss1.ignore();
-    const auto input1 = parseInput(iss1);
-
-    constexpr int part1CorrectAnswer = 1320;
-    const int part1Answer = part1(input1);
-    const bool part1Correct = part1Answer == part1CorrectAnswer;
-    fmt::print("Part 1: expected {}, got {}\n", part1CorrectAnswer,
-               fmt::styled(part1Answer, fmt::fg(part1Correct ? fmt::color::green : fmt::color::red)));
-
-    constexpr int part2CorrectAnswer = 145;
-    const int part2Answer = part2(input1);
-    const bool part2Correct = part2Answer == part2CorrectAnswer;
-    fmt::print("Part 2: expected {}, got {}\n", part2CorrectAnswer,
-               fmt::styled(part2Answer, fmt::fg(part2Correct ? fmt::color::green : fmt::color::red)));
-
-    return {part1Correct, part2Correct};
+constexpr int part2(const Input& input) {
+    Boxes<std::string_view> boxes;
+    for (std::string_view sv : input) boxes.apply(sv);
+    return boxes.focusingPower();
 }
 
-int main() {
-    auto [test1, test2] = test();
-    if (!test1) return 1;
-    auto in = std::ifstream(kInputFilename.data());
-    if (!in) {
-        fmt::print("Cannot open '{}'\n", kInputFilename);
-        return -1;
+// Both parts step by step, for --stream
+struct Fold {
+    Boxes<std::string> boxes;
+    int sum1{};
+
+    void add(std::string_view step) {
+        if (step.empty()) return;
+        sum1 += HASH(step);
+        boxes.apply(step);
     }
-    const auto input = parseInput(in);
+    int part1() const { return sum1; }
+    int part2() const { return boxes.focusingPower(); }
+};
 
-    auto getTimeColor = [](const auto& elapsed) {
-        return elapsed < 100ms ? fmt::color::light_green : elapsed < 1s ? fmt::color::orange : fmt::color::orange_red;
+std::vector<aoc::Sample> samples() {
+    constexpr std::string_view sample1{R"(
+rn=1,cm-,qp=3,cm=2,qp-,pc=4,ot=9,ab=5,pc-,pc=6,ot=7
+)"};
+    static_assert(part1(parseInput(aoc::sampleText(sample1))) == 1320);
+    static_assert(part2(parseInput(aoc::sampleText(sample1))) == 145);
+    return {
+        aoc::checkedAtBuild(aoc::makeSample(1, sample1, 1320, parseInput, part1)),
+        aoc::checkedAtBuild(aoc::makeSample(2, sample1, 145, parseInput, part2)),
     };
-    auto startTime = cron::steady_clock::now();
-    const auto part1Ans = part1(input);
-    cron::duration<double> elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 1: {} in {}\n", fmt::styled(part1Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+}
 
-    if (!test2) return 2;
-    startTime = cron::steady_clock::now();
-    const auto part2Ans = part2(input);
-    elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 2: {} in {}\n", fmt::styled(part2Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+const aoc::Day& getDay() {
+    static const aoc::Day day = aoc::withStream<Fold>(
+        aoc::makeDay("day15", kInputFilename, samples(), parseInput, part1, part2), ",\n");
+    return day;
 }
+
+} // namespace day15
@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day15
+{
+const aoc::Day& getDay();
+} // namespace day15
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day15::getDay(), argc, argv);
+}
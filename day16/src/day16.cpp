@@ -1,142 +1,140 @@
+#include <aoc/day.hpp>
+#include <aoc/grid.hpp>
+#include <aoc/input.hpp>
+#include <aoc/thread_pool.hpp>
 #include <fmt/format.h>
-#include <fmt/color.h>
 #include <vector>
-#include <sstream>
-#include <fstream>
+#include <string>
 #include <numeric>
 #include <algorithm>
-#include <stack>
+#include <optional>
+#include <tuple>
 #include <ranges>
-#include <chrono>
-namespace cron = std::chrono;
-using namespace std::chrono_literals;
 namespace ranges = std::ranges;
 namespace views = std::views;
 
+namespace day16
+{
+
 static constexpr std::string_view kInputFilename = "day16.txt";
 
-using Input = std::vector<std::string>;
+using Input = aoc::Grid<char>;
 
-Input parseInput(std::istream& in) {
-    Input res;
-    for (std::string line; std::getline(in, line);) res.push_back(line);
-    return res;
+constexpr char kOutside = ' ';
+
+// One cell of kOutside around the contraption, a beam stepping onto it has left
+Input parseInput(std::string_view text) {
+    return Input::fromLines(aoc::splitLines(text), 1, kOutside);
 }
 
 struct Dir {
-    int row;
-    int col;
+    size_t cell;
     char rep;
-    Dir(int r, int c, char rep) : row{r}, col{c}, rep{rep} {}
-    int getBin() const {
+    uint8_t getBin() const {
         if (rep == 'T') return 1;
         if (rep == 'B') return 2;
         if (rep == 'L') return 4;
         if (rep == 'R') return 8;
         return 0;
     }
-    Dir next(int rows, int cols) const {
-        int r = row;
-        int c = col;
-        if (rep == 'T') --r;
-        if (rep == 'B') ++r;
-        if (rep == 'L') --c;
-        if (rep == 'R') ++c;
-        if (!(0 <= r && r < rows && 0 <= c && c < cols)) r = c = -1;
-        return {r, c, rep};
+    Dir next(ptrdiff_t stride) const {
+        if (rep == 'T') return {cell - stride, rep};
+        if (rep == 'B') return {cell + stride, rep};
+        if (rep == 'L') return {cell - 1, rep};
+        return {cell + 1, rep};
     }
-    Dir bend(char lens, int rows, int cols) const {
-        int r = row;
-        int c = col;
+    Dir bend(char lens, ptrdiff_t stride) const {
         char dir = rep;
         if (lens == '/') {
-            if (rep == 'T') ++c, dir = 'R';
-            if (rep == 'B') --c, dir = 'L';
-            if (rep == 'L') ++r, dir = 'B';
-            if (rep == 'R') --r, dir = 'T';
+            if (rep == 'T') dir = 'R';
+            if (rep == 'B') dir = 'L';
+            if (rep == 'L') dir = 'B';
+            if (rep == 'R') dir = 'T';
         } else {
-            if (rep == 'T') --c, dir = 'L';
-            if (rep == 'B') ++c, dir = 'R';
-            if (rep == 'L') --r, dir = 'T';
-            if (rep == 'R') ++r, dir = 'B';
+            if (rep == 'T') dir = 'L';
+            if (rep == 'B') dir = 'R';
+            if (rep == 'L') dir = 'T';
+            if (rep == 'R') dir = 'B';
         }
-        if (!(0 <= r && r < rows && 0 <= c && c < cols)) r = c = -1;
-        return {r, c, dir};
+        return Dir{cell, dir}.next(stride);
     }
-    std::pair<Dir, Dir> split(char lens, int rows, int cols) const {
-        int r1 = row;
-        int c1 = col;
-        char dir1 = rep;
-        int r2 = row;
-        int c2 = col;
-        char dir2 = rep;
+    std::pair<Dir, std::optional<Dir>> split(char lens, ptrdiff_t stride) const {
         if (lens == '|') {
-            if (rep == 'T' || rep == 'B') return {next(cols, rows), {-1, -1, '.'}};
-            --r1, dir1 = 'T', ++r2, dir2 = 'B';
-        } else {
-            if (rep == 'L' || rep == 'R') return {next(cols, rows), {-1, -1, '.'}};
-            --c1, dir1 = 'L', ++c2, dir2 = 'R';
+            if (rep == 'T' || rep == 'B') return {next(stride), std::nullopt};
+            return {Dir{cell, 'T'}.next(stride), Dir{cell, 'B'}.next(stride)};
         }
-        if (!(0 <= r1 && r1 < rows && 0 <= c1 && c1 < cols)) r1 = c1 = -1;
-        if (!(0 <= r2 && r2 < rows && 0 <= c2 && c2 < cols)) r2 = c2 = -1;
-        return {{r1, c1, dir1}, {r2, c2, dir2}};
+        if (rep == 'L' || rep == 'R') return {next(stride), std::nullopt};
+        return {Dir{cell, 'L'}.next(stride), Dir{cell, 'R'}.next(stride)};
     }
 };
 
-int part1(const Input& input, int sr = 0, int sc = 0, char sdir = 'R') {
-    std::vector<std::vector<uint8_t>> visited(input.size(), std::vector<uint8_t>(input[0].size()));
-    std::stack<Dir> st;
-    st.emplace(sr, sc, sdir);
-    visited[sr][sc] |= st.top().getBin();
-    Input inp = input;
-    inp[sr][sc] = '#';
+// Directions seen per cell and the beams left to follow, reused from one start to the next
+struct Scratch {
+    aoc::Grid<uint8_t> visited;
+    std::vector<Dir> st;
+};
+
+// Cells a beam entering (sr, sc) towards `sdir` energizes
+int energize(const Input& input, Scratch& scratch, int sr, int sc, char sdir) {
+    const ptrdiff_t stride = input.stride();
+    auto& visited = scratch.visited;
+    if (visited.storage().size() != input.storage().size()) visited = aoc::Grid<uint8_t>::shapedLike(input);
+    ranges::fill(visited.storage(), uint8_t{0});
+    auto& st = scratch.st;
+    st.push_back({input.index(sr, sc), sdir});
+    visited[st.back().cell] |= st.back().getBin();
+    auto push = [&](const Dir& next) {
+        if (input[next.cell] == kOutside || (visited[next.cell] & next.getBin()) != 0) return;
+        visited[next.cell] |= next.getBin();
+        st.push_back(next);
+    };
     while (!st.empty()) {
-        auto curr = st.top();
-        st.pop();
-        Dir next{-1, -1, '.'};
-        Dir next2{-1, -1, '.'};
-        if (char lens = input[curr.row][curr.col]; lens == '.') {
-            next = curr.next((int)input.size(), (int)input[0].size());
+        auto curr = st.back();
+        st.pop_back();
+        if (char lens = input[curr.cell]; lens == '.') {
+            push(curr.next(stride));
         } else if (lens == '|' || lens == '-') {
-            std::tie(next, next2) = curr.split(lens, (int)input.size(), (int)input[0].size());
+            const auto [next, next2] = curr.split(lens, stride);
+            push(next);
+            if (next2) push(*next2);
         } else {
-            next = curr.bend(lens, (int)input.size(), (int)input[0].size());
-        }
-        if (next.row != -1) {
-            if ((visited[next.row][next.col] & next.getBin()) == 0) {
-                visited[next.row][next.col] |= next.getBin();
-                st.push(next);
-                inp[next.row][next.col] = '#';
-            }
-        }
-        if (next2.row != -1) {
-            if ((visited[next2.row][next2.col] & next2.getBin()) == 0) {
-                visited[next2.row][next2.col] |= next2.getBin();
-                st.push(next2);
-                inp[next2.row][next2.col] = '#';
-            }
+            push(curr.bend(lens, stride));
         }
     }
     int res{};
-    for (auto& line : inp) res += (int)ranges::count(line, '#');
+    for (int r = 0; r < visited.rows(); ++r)
+        res += static_cast<int>(ranges::count_if(visited.row(r), [](uint8_t bins) { return bins != 0; }));
     return res;
 }
 
+int part1(const Input& input) {
+    Scratch scratch;
+    return energize(input, scratch, 0, 0, 'R');
+}
+
+// Every start along the border is independent, they are spread over the shared thread pool
 int part2(const Input& input) {
-    int res{};
-    for (int sc = 0; sc < (int)input[0].size(); ++sc) {
-        res = std::max(res, part1(input, 0, sc, 'B'));
-        res = std::max(res, part1(input, (int)input.size() - 1, sc, 'T'));
+    std::vector<std::tuple<int, int, char>> starts;
+    for (int sc = 0; sc < input.cols(); ++sc) {
+        starts.emplace_back(0, sc, 'B');
+        starts.emplace_back(input.rows() - 1, sc, 'T');
     }
-    for (int sr = 0; sr < (int)input.size(); ++sr) {
-        res = std::max(res, part1(input, sr, 0, 'R'));
-        res = std::max(res, part1(input, sr, (int)input[0].size() - 1, 'L'));
+    for (int sr = 0; sr < input.rows(); ++sr) {
+        starts.emplace_back(sr, 0, 'R');
+        starts.emplace_back(sr, input.cols() - 1, 'L');
     }
-    return res;
+    aoc::PerWorker<Scratch> scratch;
+    return aoc::parallelReduce(
+        starts.size(), 0,
+        [&](size_t i) {
+            const auto [sr, sc, sdir] = starts[i];
+            return energize(input, scratch.local(), sr, sc, sdir);
+        },
+        [](int a, int b) { return std::max(a, b); });
 }
 
-std::pair<bool, bool> test() {
-    std::istringstream iss1{R"(
+std::vector<aoc::Sample> samples() {
+    constexpr std::string_view sample1{R"(
 .|...\....
 |.-.\.....
 .....|-...
@@ -148,47 +146,15 @@ std::pair<bool, bool> test() {
 .|....-|.\
 ..//.|....
 )"};
-    iss1.ignore();
-    const auto input1 = parseInput(iss1);
-
-    constexpr int part1CorrectAnswer = 46;
-    const int part1Answer = part1(input1);
-    const bool part1Correct = part1Answer == part1CorrectAnswer;
-    fmt::print("Part 1: expected {}, got {}\n", part1CorrectAnswer,
-               fmt::styled(part1Answer, fmt::fg(part1Correct ? fmt::color::green : fmt::color::red)));
-
-    constexpr int part2CorrectAnswer = 51;
-    const int part2Answer = part2(input1);
-    const bool part2Correct = part2Answer == part2CorrectAnswer;
-    fmt::print("Part 2: expected {}, got {}\n", part2CorrectAnswer,
-               fmt::styled(part2Answer, fmt::fg(part2Correct ? fmt::color::green : fmt::color::red)));
-
-    return {part1Correct, part2Correct};
-}
-
-int main() {
-    auto [test1, test2] = test();
-    if (!test1) return 1;
-    auto in = std::ifstream(kInputFilename.data());
-    if (!in) {
-        fmt::print("Cannot open '{}'\n", kInputFilename);
-        return -1;
-    }
-    const auto input = parseInput(in);
-
-    auto getTimeColor = [](const auto& elapsed) {
-        return elapsed < 100ms ? fmt::color::light_green : elapsed < 1s ? fmt::color::orange : fmt::color::orange_red;
+    return {
+        aoc::makeSample(1, sample1, 46, parseInput, part1),
+        aoc::makeSample(2, sample1, 51, parseInput, part2),
     };
-    auto startTime = cron::steady_clock::now();
-    const auto part1Ans = part1(input);
-    cron::duration<double> elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 1: {} in {}\n", fmt::styled(part1Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+}
 
-    if (!test2) return 2;
-    startTime = cron::steady_clock::now();
-    const auto part2Ans = part2(input);
-    elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 2: {} in {}\n", fmt::styled(part2Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+const aoc::Day& getDay() {
+    static const aoc::Day day = aoc::makeDay("day16", kInputFilename, samples(), parseInput, part1, part2);
+    return day;
 }
+
+} // namespace day16
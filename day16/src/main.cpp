@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day16
+{
+const aoc::Day& getDay();
+} // namespace day16
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day16::getDay(), argc, argv);
+}
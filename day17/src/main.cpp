@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day17
+{
+const aoc::Day& getDay();
+} // namespace day17
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day17::getDay(), argc, argv);
+}
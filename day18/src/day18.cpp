@@ -1,37 +1,36 @@
+#include <aoc/day.hpp>
+#include <aoc/input.hpp>
+#include <aoc/scanner.hpp>
 #include <fmt/format.h>
-#include <fmt/color.h>
 #include <vector>
-#include <sstream>
-#include <fstream>
+#include <string>
 #include <numeric>
 #include <algorithm>
 #include <set>
 #include <stack>
 #include <ranges>
-#include <chrono>
-namespace cron = std::chrono;
-using namespace std::chrono_literals;
 namespace ranges = std::ranges;
 namespace views = std::views;
 
+namespace day18
+{
+
 static constexpr std::string_view kInputFilename = "day18.txt";
 
-using Input = std::vector<std::string>;
+using Input = std::vector<std::string_view>;
 
-Input parseInput(std::istream& in) {
-    Input res;
-    for (std::string line; std::getline(in, line);) res.push_back(line);
-    return res;
+constexpr Input parseInput(std::string_view text) {
+    return aoc::splitLines(text);
 }
 
-int part1(const Input& input, int sr, int sc) {
+// Flood fill of a set of every cell from (sr, sc) inside the trench, kept as the reference of part 1
+int part1Reference(const Input& input, int sr, int sc) {
     std::set<std::pair<int, int>> trenches;
     trenches.emplace(0, 0);
     for (int r = 0, c = 0; auto& line : input) {
-        std::istringstream iss{line};
-        char dir;
-        int len;
-        iss >> dir >> len;
+        char dir{};
+        int len{};
+        aoc::Scanner{line} >> dir >> len;
         const int dr = dir == 'U' ? -1 : dir == 'D' ? 1 : 0;
         const int dc = dir == 'L' ? -1 : dir == 'R' ? 1 : 0;
         while (len--) trenches.emplace(r += dr, c += dc);
@@ -59,77 +58,45 @@ int part1(const Input& input, int sr, int sc) {
     return res + (int)trenches.size();
 }
 
-int64_t part2(const Input& input) {
-    std::vector<std::pair<int64_t, int64_t>> p;
-    p.emplace_back(0, 0);
-    for (int64_t r = 0, c = 0; auto& line : input) {
-        std::istringstream iss{line};
-        char dir;
-        int64_t len;
-        std::string color;
-        iss >> dir >> len >> color;
-        dir = "RDLU"[end(color)[-2] - '0'];
-        len = std::stoll(color.substr(2, 5), nullptr, 16);
-        const int dr = dir == 'U' ? -1 : dir == 'D' ? 1 : 0;
-        const int dc = dir == 'L' ? -1 : dir == 'R' ? 1 : 0;
-        r += dr * len;
-        c += dc * len;
-        p.emplace_back(r, c);
-    }
-    // https://en.wikipedia.org/wiki/Shoelace_formula#Trapezoid_formula
+// Cubic meters of the lagoon dug by the plan, `readMove` gives the direction and length of each line:
+// https://en.wikipedia.org/wiki/Shoelace_formula#Trapezoid_formula over the corners, plus the half of the trench
+// outside of it
+template <class ReadMove>
+constexpr int64_t lagoonVolume(const Input& input, ReadMove readMove) {
     int64_t area{};
-    for (auto [p1, p2] : p | views::adjacent<2>) {
-        auto& [y1, x1] = p1;
-        auto& [y2, x2] = p2;
-        area += (y1 + y2) * (x1 - x2);
-        area += std::abs(y2 - y1) + std::abs(x2 - x1);
+    for (int64_t r = 0, c = 0; auto& line : input) {
+        const auto [dir, len] = readMove(line);
+        const int64_t nr = r + (dir == 'U' ? -len : dir == 'D' ? len : 0);
+        const int64_t nc = c + (dir == 'L' ? -len : dir == 'R' ? len : 0);
+        area += (r + nr) * (c - nc) + len;
+        r = nr;
+        c = nc;
     }
     return area / 2 + 1;
 }
 
-std::pair<bool, bool> test() {
-    auto testPart1 = [](std::istream& is, int correctAnswer) {
-        const auto input = parseInput(is);
-        const int answer = part1(input, 1, 1);
-        const bool correct = answer == correctAnswer;
-        fmt::print("Part 1: expected {}, got {}\n", correctAnswer,
-                   fmt::styled(answer, fmt::fg(correct ? fmt::color::green : fmt::color::red)));
-        return correct;
-    };
-    auto testPart2 = [](std::istream& is, int64_t correctAnswer) {
-        const auto input = parseInput(is);
-        const auto answer = part2(input);
-        const bool correct = answer == correctAnswer;
-        fmt::print("Part 2: expected {}, got {}\n", correctAnswer,
-                   fmt::styled(answer, fmt::fg(correct ? fmt::color::green : fmt::color::red)));
-        return correct;
-    };
+constexpr int64_t part1(const Input& input) {
+    return lagoonVolume(input, [](std::string_view line) {
+        char dir{};
+        int64_t len{};
+        aoc::Scanner{line} >> dir >> len;
+        return std::pair{dir, len};
+    });
+}
 
-    constexpr std::pair<std::string_view, int> part1Cases[] = {{R"(
-R 6 (#70c710)
-D 5 (#0dc571)
-L 2 (#5713f0)
-D 2 (#d2c081)
-R 2 (#59c680)
-D 2 (#411b91)
-L 5 (#8ceee2)
-U 2 (#caa173)
-L 1 (#1b58a2)
-U 2 (#caa171)
-R 2 (#7807d2)
-U 3 (#a77fa3)
-L 2 (#015232)
-U 2 (#7a21e3)
-)",
-                                                                62}};
-    bool part1Correct = true;
-    for (auto [sv, correctAnswer] : part1Cases) {
-        std::istringstream iss{sv.data()};
-        iss.ignore();
-        part1Correct &= testPart1(iss, correctAnswer);
-    }
+// The move is in the color: five hex digits of length, then the direction
+constexpr int64_t part2(const Input& input) {
+    return lagoonVolume(input, [](std::string_view line) {
+        char dir{};
+        int64_t len{};
+        std::string_view color;
+        aoc::Scanner{line} >> dir >> len >> color;
+        return std::pair{"RDLU"[end(color)[-2] - '0'], aoc::parseInt<int64_t>(color.substr(2, 5), 16)};
+    });
+}
 
-    constexpr std::pair<std::string_view, int64_t> part2Cases[] = {{R"(
+std::vector<aoc::Sample> samples() {
+    constexpr std::string_view sample1{R"(
 R 6 (#70c710)
 D 5 (#0dc571)
 L 2 (#5713f0)
@@ -144,40 +111,20 @@ R 2 (#7807d2)
 U 3 (#a77fa3)
 L 2 (#015232)
 U 2 (#7a21e3)
-)",
-                                                                    952408144115LL}};
-    bool part2Correct = true;
-    for (auto [sv, correctAnswer] : part2Cases) {
-        std::istringstream iss{sv.data()};
-        iss.ignore();
-        part2Correct &= testPart2(iss, correctAnswer);
-    }
-    return {part1Correct, part2Correct};
-}
-
-int main() {
-    auto [test1, test2] = test();
-    if (!test1) return 1;
-    auto in = std::ifstream(kInputFilename.data());
-    if (!in) {
-        fmt::print("Cannot open '{}'\n", kInputFilename);
-        return -1;
-    }
-    const auto input = parseInput(in);
-
-    auto getTimeColor = [](const auto& elapsed) {
-        return elapsed < 100ms ? fmt::color::light_green : elapsed < 1s ? fmt::color::orange : fmt::color::orange_red;
+)"};
+    static_assert(part1(parseInput(aoc::sampleText(sample1))) == 62);
+    static_assert(part2(parseInput(aoc::sampleText(sample1))) == 952408144115LL);
+    return {
+        aoc::checkedAtBuild(aoc::makeSample(1, sample1, 62, parseInput, part1)),
+        aoc::checkedAtBuild(aoc::makeSample(2, sample1, 952408144115LL, parseInput, part2)),
     };
-    auto startTime = cron::steady_clock::now();
-    const auto part1Ans = part1(input, 1, 1);
-    cron::duration<double> elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 1: {} in {}\n", fmt::styled(part1Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+}
 
-    if (!test2) return 2;
-    startTime = cron::steady_clock::now();
-    const auto part2Ans = part2(input);
-    elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 2: {} in {}\n", fmt::styled(part2Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+const aoc::Day& getDay() {
+    static const aoc::Day day =
+        aoc::withReference(aoc::makeDay("day18", kInputFilename, samples(), parseInput, part1, part2), 1, parseInput,
+                           [](const Input& input) { return part1Reference(input, 1, 1); });
+    return day;
 }
+
+} // namespace day18
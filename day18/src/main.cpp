@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day18
+{
+const aoc::Day& getDay();
+} // namespace day18
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day18::getDay(), argc, argv);
+}
@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day19
+{
+const aoc::Day& getDay();
+} // namespace day19
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day19::getDay(), argc, argv);
+}
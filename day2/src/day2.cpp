@@ -1,17 +1,19 @@
+#include <aoc/day.hpp>
+#include <aoc/input.hpp>
+#include <aoc/scanner.hpp>
 #include <fmt/format.h>
-#include <fmt/color.h>
-#include <sstream>
 #include <vector>
+#include <memory_resource>
+#include <string>
 #include <numeric>
 #include <algorithm>
 #include <ranges>
-#include <fstream>
-#include <chrono>
-namespace cron = std::chrono;
-using namespace std::chrono_literals;
 namespace ranges = std::ranges;
 namespace views = std::views;
 
+namespace day2
+{
+
 static constexpr std::string_view kInputFilename = "day2.txt";
 
 struct SetOfCubes {
@@ -22,108 +24,110 @@ struct SetOfCubes {
 };
 
 struct Game {
-    std::vector<SetOfCubes> subsets;
+    std::pmr::vector<SetOfCubes> subsets;
 };
 
-using Input = std::vector<Game>;
-
-Input parseInput(std::istream& in) {
-    Input res;
-    for (std::string ignore; in >> ignore >> ignore;) {
-        Game game;
-        for (bool playing = true; playing;) {
-            SetOfCubes subset{};
-            for (int val; in >> val >> ignore;) {
-                if (ignore[0] == 'r') {
-                    subset.red = val;
-                } else if (ignore[0] == 'g') {
-                    subset.green = val;
-                } else {
-                    subset.blue = val;
-                }
-                if (ignore.back() != ',') {
-                    game.subsets.emplace_back(std::move(subset));
-                    if (ignore.back() != ';') playing = false;
-                    break;
-                }
+using Input = std::pmr::vector<Game>;
+
+// Fills `game` from its line "Game 1: 3 blue, 4 red; 1 red, 2 green", false for a line without a game
+bool parseGame(std::string_view line, Game& game) {
+    aoc::Scanner in{line};
+    game.subsets.clear();
+    std::string_view ignore;
+    if (!(in >> ignore >> ignore)) return false;
+    for (bool playing = true; playing;) {
+        SetOfCubes subset{};
+        playing = false;
+        for (int val; in >> val >> ignore;) {
+            if (ignore[0] == 'r') {
+                subset.red = val;
+            } else if (ignore[0] == 'g') {
+                subset.green = val;
+            } else {
+                subset.blue = val;
+            }
+            if (ignore.back() != ',') {
+                game.subsets.push_back(subset);
+                playing = ignore.back() == ';';
+                break;
             }
         }
-        res.emplace_back(std::move(game));
+    }
+    return true;
+}
+
+Input parseInput(std::string_view text, std::pmr::memory_resource* arena) {
+    Input res{arena};
+    for (std::string_view line : aoc::splitLines(text)) {
+        Game game{std::pmr::vector<SetOfCubes>{arena}};
+        if (parseGame(line, game)) res.emplace_back(std::move(game));
     }
     return res;
 }
 
-int part1(const Input& input) {
+bool isPossible(const Game& game) {
     static constexpr SetOfCubes input0{12, 13, 14};
+    return ranges::all_of(game.subsets, [&](auto& subset) { return subset < input0; });
+}
+
+int power(const Game& game) {
+    SetOfCubes minSet{};
+    for (auto& subset : game.subsets) {
+        minSet.red = std::min(minSet.red, -subset.red);
+        minSet.green = std::min(minSet.green, -subset.green);
+        minSet.blue = std::min(minSet.blue, -subset.blue);
+    }
+    return -minSet.red * minSet.green * minSet.blue;
+}
+
+int part1(const Input& input) {
     int res{};
     for (int gameId = 0; auto& game : input) {
         ++gameId;
-        if (ranges::all_of(game.subsets, [&](auto& subset) { return subset < input0; })) res += gameId;
+        if (isPossible(game)) res += gameId;
     }
     return res;
 }
 
 int part2(const Input& input) {
-    return std::transform_reduce(begin(input), end(input), 0, std::plus{}, [](const Game& game) {
-        SetOfCubes minSet{};
-        for (auto& subset : game.subsets) {
-            minSet.red = std::min(minSet.red, -subset.red);
-            minSet.green = std::min(minSet.green, -subset.green);
-            minSet.blue = std::min(minSet.blue, -subset.blue);
-        }
-        return -minSet.red * minSet.green * minSet.blue;
-    });
+    return std::transform_reduce(begin(input), end(input), 0, std::plus{}, power);
 }
 
-std::pair<bool, bool> test() {
-    std::istringstream iss1{R"(
+// Both sums game by game, for --stream. The subsets of one game at a time are kept.
+struct Fold {
+    Game game;
+    int gameId{};
+    int sum1{};
+    int sum2{};
+
+    void add(std::string_view line) {
+        if (!parseGame(line, game)) return;
+        ++gameId;
+        if (isPossible(game)) sum1 += gameId;
+        sum2 += power(game);
+    }
+    int part1() const { return sum1; }
+    int part2() const { return sum2; }
+};
+
+std::vector<aoc::Sample> samples() {
+    constexpr std::string_view sample1{R"(
 Game 1: 3 blue, 4 red; 1 red, 2 green, 6 blue; 2 green
 Game 2: 1 blue, 2 green; 3 green, 4 blue, 1 red; 1 green, 1 blue
 Game 3: 8 green, 6 blue, 20 red; 5 blue, 4 red, 13 green; 5 green, 1 red
 Game 4: 1 green, 3 red, 6 blue; 3 green, 6 red; 3 green, 15 blue, 14 red
 Game 5: 6 red, 1 blue, 3 green; 2 blue, 1 red, 2 green
 )"};
-    iss1.ignore();
-    const auto input1 = parseInput(iss1);
-
-    const int part1CorrectAnswer = 8;
-    const int part1Answer = part1(input1);
-    const bool part1Correct = part1Answer == part1CorrectAnswer;
-    fmt::print("Part 1: expected {}, got {}\n", part1CorrectAnswer,
-               fmt::styled(part1Answer, fmt::fg(part1Correct ? fmt::color::green : fmt::color::red)));
-
-    const int part2CorrectAnswer = 2286;
-    const int part2Answer = part2(input1);
-    const bool part2Correct = part2Answer == part2CorrectAnswer;
-    fmt::print("Part 2: expected {}, got {}\n", part2CorrectAnswer,
-               fmt::styled(part2Answer, fmt::fg(part2Correct ? fmt::color::green : fmt::color::red)));
-
-    return {part1Correct, part2Correct};
+    return {
+        aoc::makeSample(1, sample1, 8, parseInput, part1),
+        aoc::makeSample(2, sample1, 2286, parseInput, part2),
+    };
 }
 
-int main() {
-    auto [test1, test2] = test();
-    if (!test1) return 1;
-    auto in = std::ifstream(kInputFilename.data());
-    if (!in) {
-        fmt::print("Cannot open '{}'\n", kInputFilename);
-        return -1;
-    }
-    const auto input = parseInput(in);
-
-    auto getTimeColor = [](const auto& elapsed) {
-        return elapsed < 100ms ? fmt::color::light_green : elapsed < 1s ? fmt::color::orange : fmt::color::orange_red;
-    };
-    auto startTime = cron::steady_clock::now();
-    const auto part1Ans = part1(input);
-    cron::duration<double> elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 1: {} in {}\n", fmt::styled(part1Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
-
-    if (!test2) return 2;
-    startTime = cron::steady_clock::now();
-    const auto part2Ans = part2(input);
-    elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 2: {} in {}\n", fmt::styled(part2Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+const aoc::Day& getDay() {
+    static const aoc::Day day =
+        aoc::withStream<Fold>(aoc::makeDay("day2", kInputFilename, samples(), parseInput, part1, part2));
+    return day;
 }
+
+} // namespace day2
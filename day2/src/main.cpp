@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day2
+{
+const aoc::Day& getDay();
+} // namespace day2
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day2::getDay(), argc, argv);
+}
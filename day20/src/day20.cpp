@@ -1,32 +1,64 @@
+#include <aoc/day.hpp>
+#include <aoc/graph.hpp>
+#include <aoc/input.hpp>
+#include <aoc/scanner.hpp>
 #include <fmt/format.h>
-#include <fmt/color.h>
 #include <vector>
-#include <sstream>
-#include <fstream>
+#include <memory_resource>
+#include <string>
 #include <numeric>
 #include <algorithm>
-#include <unordered_map>
+#include <deque>
 #include <queue>
 #include <ranges>
-#include <chrono>
-namespace cron = std::chrono;
-using namespace std::chrono_literals;
 namespace ranges = std::ranges;
 namespace views = std::views;
 
+namespace day20
+{
+
 static constexpr std::string_view kInputFilename = "day20.txt";
 
 enum class Pulse { None, Low, High };
+struct Module;
+// Modules are allocated from the arena of the parse or of the part that cloned them and go back to it
+struct ModuleDeleter {
+    std::pmr::memory_resource* arena{};
+    void operator()(Module* module) const;
+};
+using ModulePtr = std::unique_ptr<Module, ModuleDeleter>;
+
+template <class T, class... Args>
+ModulePtr makeModule(std::pmr::memory_resource* arena, Args&&... args) {
+    return ModulePtr{std::pmr::polymorphic_allocator<>{arena}.new_object<T>(std::forward<Args>(args)...), {arena}};
+}
+
+// Modules are told apart by their vertex id in the wiring graph
 struct Module {
-    virtual Pulse receivePulse(const std::string&, Pulse pulse) { return pulse; }
-    virtual void addInput(const std::string&) {}
+    virtual Pulse receivePulse(uint32_t, Pulse pulse) { return pulse; }
+    virtual void addInput(uint32_t) {}
     virtual void reset() {}
+    virtual ModulePtr clone(std::pmr::memory_resource* arena) const = 0;
+    virtual void destroy(std::pmr::memory_resource* arena) = 0;
     virtual ~Module() {}
 };
-struct Broadcaster : Module {};
-struct FlipFlop : Module {
+void ModuleDeleter::operator()(Module* module) const {
+    module->destroy(arena);
+}
+// clone() and destroy() need the dynamic type for the size given back to the arena
+template <class Derived>
+struct ArenaModule : Module {
+    ModulePtr clone(std::pmr::memory_resource* arena) const override {
+        return makeModule<Derived>(arena, static_cast<const Derived&>(*this));
+    }
+    void destroy(std::pmr::memory_resource* arena) override {
+        std::pmr::polymorphic_allocator<>{arena}.delete_object(static_cast<Derived*>(this));
+    }
+};
+struct Broadcaster : ArenaModule<Broadcaster> {};
+struct FlipFlop : ArenaModule<FlipFlop> {
     bool on = false;
-    Pulse receivePulse(const std::string&, Pulse pulse) override {
+    Pulse receivePulse(uint32_t, Pulse pulse) override {
         if (pulse == Pulse::None) return Pulse::None;
         if (pulse == Pulse::High) return Pulse::None;
         on = !on;
@@ -34,11 +66,16 @@ struct FlipFlop : Module {
     }
     void reset() override { on = false; }
 };
-struct Conjunction : Module {
-    std::unordered_map<std::string, Pulse> memo;
-    void addInput(const std::string& inputName) override { memo[inputName] = Pulse::Low; }
-    Pulse receivePulse(const std::string& inputName, Pulse pulse) override {
-        memo[inputName] = pulse;
+struct Conjunction : ArenaModule<Conjunction> {
+    // Allocator-aware, so new_object() hands the arena down to the memo
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+    // Last pulse of every input, a handful at most
+    std::pmr::vector<std::pair<uint32_t, Pulse>> memo;
+    explicit Conjunction(const allocator_type& alloc) : memo{alloc} {}
+    Conjunction(const Conjunction& other, const allocator_type& alloc) : memo{other.memo, alloc} {}
+    void addInput(uint32_t input) override { memo.emplace_back(input, Pulse::Low); }
+    Pulse receivePulse(uint32_t input, Pulse pulse) override {
+        ranges::find(memo, input, &std::pair<uint32_t, Pulse>::first)->second = pulse;
         if (ranges::all_of(memo, [](auto& kv) { return kv.second == Pulse::High; })) return Pulse::Low;
         return Pulse::High;
     }
@@ -47,96 +84,119 @@ struct Conjunction : Module {
     }
 };
 
-using Input = std::pair<std::unordered_map<std::string, std::unique_ptr<Module>>,
-                        std::unordered_map<std::string, std::vector<std::string>>>;
+// Indexed by vertex id, null for the untyped modules that only receive
+using Modules = std::pmr::vector<ModulePtr>;
+using Input = std::pair<Modules, aoc::CsrGraph<>>;
+using Signal = std::tuple<uint32_t, Pulse, uint32_t, int>;
 
-Input parseInput(std::istream& in) {
-    std::vector<std::string> lines;
-    std::unordered_map<std::string, std::unique_ptr<Module>> modules;
-    for (std::string line; std::getline(in, line);) {
-        const std::string moduleRep = line.substr(0, line.find(' '));
-        if (moduleRep == "broadcaster") {
-            modules["broadcaster"] = std::make_unique<Broadcaster>();
-        } else {
-            const std::string moduleName = moduleRep.substr(1);
-            if (moduleRep[0] == '%') {
-                modules[moduleName] = std::make_unique<FlipFlop>();
-            } else {
-                modules[moduleName] = std::make_unique<Conjunction>();
-            }
+// Sender of the pulse to the broadcaster, not a vertex of the graph
+constexpr uint32_t kButton = UINT32_MAX;
+
+// Each part pushes buttons on its own copy, so parts can be repeated or run concurrently
+Modules cloneModules(const Modules& modules, std::pmr::memory_resource* arena) {
+    Modules res{arena};
+    res.reserve(modules.size());
+    for (const auto& module : modules) {
+        res.push_back(module ? module->clone(arena) : nullptr);
+        if (res.back()) res.back()->reset();
+    }
+    return res;
+}
+
+Input parseInput(std::string_view text, std::pmr::memory_resource* arena) {
+    const auto lines = aoc::splitLines(text);
+    aoc::GraphBuilder<> builder;
+    std::vector<std::pair<uint32_t, char>> kinds;
+    for (std::string_view line : lines) {
+        const std::string_view moduleRep = line.substr(0, line.find(' '));
+        const std::string_view moduleName = moduleRep == "broadcaster" ? moduleRep : moduleRep.substr(1);
+        kinds.emplace_back(builder.vertex(moduleName), moduleRep[0]);
+    }
+    for (std::string_view line : lines) {
+        const std::string_view fromRep = line.substr(0, line.find(' '));
+        const uint32_t from = builder.vertex(fromRep[0] == 'b' ? fromRep : fromRep.substr(1));
+        aoc::Scanner iss{line.substr(line.find('>') + 1)};
+        for (std::string_view tok; iss >> tok;) {
+            if (tok.back() == ',') tok.remove_suffix(1);
+            builder.addEdge(from, builder.vertex(tok));
         }
-        lines.push_back(line);
     }
-    std::unordered_map<std::string, std::vector<std::string>> adj;
-    for (auto& line : lines) {
-        const std::string fromRep = line.substr(0, line.find(' '));
-        const std::string from = fromRep[0] == 'b' ? fromRep : fromRep.substr(1);
-        std::vector<std::string> to;
-        std::istringstream iss{line.substr(line.find('>') + 1)};
-        for (std::string tok; iss >> tok;) {
-            if (tok.back() == ',') tok.pop_back();
-            to.push_back(tok);
-            if (auto it = modules.find(tok); it != end(modules)) it->second->addInput(from);
+    auto graph = builder.build(arena);
+    Modules modules{graph.size(), arena};
+    for (auto [id, kind] : kinds) {
+        if (kind == '%') {
+            modules[id] = makeModule<FlipFlop>(arena);
+        } else if (kind == '&') {
+            modules[id] = makeModule<Conjunction>(arena);
+        } else {
+            modules[id] = makeModule<Broadcaster>(arena);
         }
-        adj[from] = std::move(to);
     }
-    return std::make_pair(std::move(modules), adj);
+    for (uint32_t from = 0; from < graph.size(); ++from)
+        for (const auto& edge : graph.edges(from))
+            if (modules[edge.to]) modules[edge.to]->addInput(from);
+    return Input{std::move(modules), std::move(graph)};
 }
 
-int part1(const Input& input) {
-    auto& [modules, adj] = input;
+int part1(const Input& input, std::pmr::memory_resource* arena) {
+    auto& graph = input.second;
+    auto modules = cloneModules(input.first, arena);
+    const uint32_t broadcaster = *graph.find("broadcaster");
     int hiCnt{};
     int loCnt{};
+    std::queue<Signal, std::pmr::deque<Signal>> q{std::pmr::deque<Signal>{arena}};
     for (int t = 0; t < 1000; ++t) {
-        std::queue<std::tuple<std::string, Pulse, std::string, int>> q;
-        q.emplace("broadcaster", Pulse::Low, "button", 0);
+        q.emplace(broadcaster, Pulse::Low, kButton, 0);
         while (!q.empty()) {
-            auto [name, pulse, fromName, timestamp] = q.front();
+            auto [to, pulse, from, timestamp] = q.front();
             q.pop();
             if (pulse == Pulse::Low)
                 ++loCnt;
             else if (pulse == Pulse::High)
                 ++hiCnt;
-            if (auto it = modules.find(name); it != end(modules)) {
-                const auto pulseOut = it->second->receivePulse(fromName, pulse);
+            if (const auto& module = modules[to]) {
+                const auto pulseOut = module->receivePulse(from, pulse);
                 if (pulseOut == Pulse::None) continue;
-                if (auto adjIt = adj.find(name); adjIt != end(adj))
-                    for (auto& nb : adjIt->second) q.emplace(nb, pulseOut, name, timestamp + 1);
+                for (const auto& edge : graph.edges(to)) q.emplace(edge.to, pulseOut, to, timestamp + 1);
             }
         }
     }
     return loCnt * hiCnt;
 }
 
-int64_t part2(const Input& input) {
-    auto& [modules, adj] = input;
-    for (auto& [k, v] : modules) v->reset();
-    std::string conjName =
-        ranges::find_if(adj, [](auto& kv) { return ranges::find(kv.second, "rx") != end(kv.second); })->first;
-    std::unordered_map<std::string, std::vector<int>> cycles;
-    if (auto* p = dynamic_cast<Conjunction*>(modules.find(conjName)->second.get()); p != nullptr)
-        for (auto k : p->memo | views::keys) cycles[k];
+int64_t part2(const Input& input, std::pmr::memory_resource* arena) {
+    auto& graph = input.second;
+    auto modules = cloneModules(input.first, arena);
+    const uint32_t broadcaster = *graph.find("broadcaster");
+    const uint32_t rx = *graph.find("rx");
+    uint32_t conj{};
+    while (ranges::none_of(graph.edges(conj), [&](const auto& edge) { return edge.to == rx; })) ++conj;
+    // Button presses at which each input of the conjunction feeding rx sent a high pulse, by vertex id
+    std::pmr::vector<std::pmr::vector<int>> cycles{graph.size(), arena};
+    std::pmr::vector<uint32_t> watched{arena};
+    std::queue<Signal, std::pmr::deque<Signal>> q{std::pmr::deque<Signal>{arena}};
+    if (auto* p = dynamic_cast<Conjunction*>(modules[conj].get()); p != nullptr)
+        for (auto k : p->memo | views::keys) watched.push_back(k);
     for (int t = 1; t < 1'000'000; ++t) {
-        if (ranges::all_of(cycles, [](auto& kv) -> bool { return kv.second.size() >= 2; })) break;
-        std::queue<std::tuple<std::string, Pulse, std::string, int>> q;
-        q.emplace("broadcaster", Pulse::Low, "button", 0);
+        if (ranges::all_of(watched, [&](uint32_t k) { return cycles[k].size() >= 2; })) break;
+        q.emplace(broadcaster, Pulse::Low, kButton, 0);
         while (!q.empty()) {
-            auto [name, pulse, fromName, timestamp] = q.front();
+            auto [to, pulse, from, timestamp] = q.front();
             q.pop();
-            if (auto it = cycles.find(fromName); it != end(cycles))
-                if (pulse == Pulse::High) it->second.push_back(t);
-            if (auto it = modules.find(name); it != end(modules)) {
-                const auto pulseOut = it->second->receivePulse(fromName, pulse);
+            if (pulse == Pulse::High && from != kButton && ranges::find(watched, from) != end(watched))
+                cycles[from].push_back(t);
+            if (const auto& module = modules[to]) {
+                const auto pulseOut = module->receivePulse(from, pulse);
                 if (pulseOut == Pulse::None) continue;
-                if (auto adjIt = adj.find(name); adjIt != end(adj))
-                    for (auto& nb : adjIt->second) q.emplace(nb, pulseOut, name, timestamp + 1);
+                for (const auto& edge : graph.edges(to)) q.emplace(edge.to, pulseOut, to, timestamp + 1);
             }
         }
     }
     int64_t res{1};
-    for (auto& [k, v] : cycles) {
+    for (uint32_t k : watched) {
+        const auto& v = cycles[k];
         if (v[1] - v[0] != v[0]) {
-            fmt::print("Anomaly at {} {} {}\n", k, v[0], v[1]);
+            fmt::print("Anomaly at {} {} {}\n", graph.name(k), v[0], v[1]);
             return -1;
         }
         res = std::lcm(res, v[1] - v[0]);
@@ -144,65 +204,30 @@ int64_t part2(const Input& input) {
     return res;
 }
 
-std::pair<bool, bool> test() {
-    auto testPart1 = [](std::istream& is, int64_t correctAnswer) {
-        const auto input = parseInput(is);
-        const auto answer = part1(input);
-        const bool correct = answer == correctAnswer;
-        fmt::print("Part 1: expected {}, got {}\n", correctAnswer,
-                   fmt::styled(answer, fmt::fg(correct ? fmt::color::green : fmt::color::red)));
-        return correct;
-    };
-    constexpr std::pair<std::string_view, int> part1Cases[] = {{R"(
+std::vector<aoc::Sample> samples() {
+    constexpr std::string_view sample1{R"(
 broadcaster -> a, b, c
 %a -> b
 %b -> c
 %c -> inv
 &inv -> a
-)",
-                                                                32000000},
-                                                               {R"(
+)"};
+    constexpr std::string_view sample2{R"(
 broadcaster -> a
 %a -> inv, con
 &inv -> b
 %b -> con
 &con -> output
-)",
-                                                                11687500}};
-    bool part1Correct = true;
-    for (auto [sv, correctAnswer] : part1Cases) {
-        std::istringstream iss{sv.data()};
-        iss.ignore();
-        part1Correct &= testPart1(iss, correctAnswer);
-    }
-
-    bool part2Correct = true;
-    return {part1Correct, part2Correct};
-}
-
-int main() {
-    auto [test1, test2] = test();
-    if (!test1) return 1;
-    auto in = std::ifstream(kInputFilename.data());
-    if (!in) {
-        fmt::print("Cannot open '{}'\n", kInputFilename);
-        return -1;
-    }
-    const auto input = parseInput(in);
-
-    auto getTimeColor = [](const auto& elapsed) {
-        return elapsed < 100ms ? fmt::color::light_green : elapsed < 1s ? fmt::color::orange : fmt::color::orange_red;
+)"};
+    return {
+        aoc::makeSample(1, sample1, 32000000, parseInput, part1),
+        aoc::makeSample(1, sample2, 11687500, parseInput, part1),
     };
-    auto startTime = cron::steady_clock::now();
-    const auto part1Ans = part1(input);
-    cron::duration<double> elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 1: {} in {}\n", fmt::styled(part1Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+}
 
-    if (!test2) return 2;
-    startTime = cron::steady_clock::now();
-    const auto part2Ans = part2(input);
-    elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 2: {} in {}\n", fmt::styled(part2Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+const aoc::Day& getDay() {
+    static const aoc::Day day = aoc::makeDay("day20", kInputFilename, samples(), parseInput, part1, part2);
+    return day;
 }
+
+} // namespace day20
@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day20
+{
+const aoc::Day& getDay();
+} // namespace day20
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day20::getDay(), argc, argv);
+}
@@ -1,87 +1,67 @@
+#include <aoc/day.hpp>
+#include <aoc/flat_hash_map.hpp>
+#include <aoc/grid.hpp>
+#include <aoc/input.hpp>
 #include <fmt/format.h>
-#include <fmt/color.h>
 #include <vector>
-#include <sstream>
-#include <fstream>
 #include <numeric>
 #include <algorithm>
 #include <queue>
 #include <array>
-#include <unordered_map>
 #include <ranges>
-#include <chrono>
-namespace cron = std::chrono;
-using namespace std::chrono_literals;
 namespace ranges = std::ranges;
 namespace views = std::views;
 
+namespace day21
+{
+
 static constexpr std::string_view kInputFilename = "day21.txt";
 
-namespace std
-{
-template <>
-struct hash<std::pair<int, int>> {
-    size_t hashCombine(size_t seed, int val) const {
-        return seed ^= std::hash<int>{}(val) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-    }
-    size_t operator()(const std::pair<int, int>& x) const { return hashCombine(hashCombine(0, x.first), x.second); }
-};
-} // namespace std
+using Input = aoc::Grid<char>;
 
-using Input = std::vector<std::string>;
+// One cell of rock around the garden, so part 1 never steps out of it
+Input parseInput(std::string_view text) {
+    return Input::fromLines(aoc::splitLines(text), 1, '#');
+}
 
-Input parseInput(std::istream& in) {
-    Input res;
-    for (std::string line; std::getline(in, line);) res.push_back(line);
-    return res;
+size_t findStart(const Input& input) {
+    for (int r = 0; r < input.rows(); ++r)
+        for (int c = 0; c < input.cols(); ++c)
+            if (input(r, c) == 'S') return input.index(r, c);
+    return 0;
 }
 
 int part1(const Input& input, int steps) {
-    int sr{-1};
-    int sc{-1};
-    for (auto [r, c] : views::cartesian_product(views::iota(0U, input.size()), views::iota(0U, input[0].size())))
-        if (input[r][c] == 'S') {
-            sr = r;
-            sc = c;
-            break;
-        }
-    std::queue<std::tuple<size_t, size_t, int>> q;
-    q.emplace(sr, sc, 0);
-    std::vector<std::vector<int>> visited(input.size(), std::vector<int>(input[0].size(), -1));
-    visited[sr][sc] = 0;
+    const size_t start = findStart(input);
+    std::queue<std::pair<size_t, int>> q;
+    q.emplace(start, 0);
+    auto visited = aoc::Grid<int>::shapedLike(input, -1);
+    visited[start] = 0;
     while (!q.empty()) {
-        auto [r, c, dist] = q.front();
+        auto [cell, dist] = q.front();
         if (dist == steps) break;
         q.pop();
-        for (auto [dr, dc] : std::array<std::pair<int, int>, 4>{{{-1, 0}, {0, 1}, {1, 0}, {0, -1}}})
-            if (const size_t nr = r + dr, nc = c + dc;
-                r < input.size() && c < input[0].size() && input[nr][nc] != '#' && visited[nr][nc] < dist + 1) {
-                visited[nr][nc] = dist + 1;
-                q.emplace(nr, nc, dist + 1);
+        for (ptrdiff_t offset : input.offsets4())
+            if (const size_t next = cell + offset; input[next] != '#' && visited[next] < dist + 1) {
+                visited[next] = dist + 1;
+                q.emplace(next, dist + 1);
             }
     }
     return static_cast<int>(q.size());
 }
 
 int64_t part2(const Input& input, int steps) {
-    int sr{};
-    int sc{};
-    for (auto [r, c] : views::cartesian_product(views::iota(0U, input.size()), views::iota(0U, input[0].size())))
-        if (input[r][c] == 'S') {
-            sr = r;
-            sc = c;
-            break;
-        }
+    const auto [sr, sc] = input.position(findStart(input));
     std::queue<std::tuple<int, int, int>> q;
     q.emplace(sr, sc, 0);
-    std::unordered_map<std::pair<int, int>, int> visited;
-    visited.emplace(std::make_pair(sr, sc), 0);
+    aoc::FlatHashMap<std::pair<int, int>, int> visited;
+    visited.try_emplace({sr, sc}, 0);
     auto loop = [](int r, int rows) {
         r -= r / rows * rows;
         r += rows;
         return r % rows;
     };
-    auto [quot, rem] = std::div(steps, (int)input.size());
+    auto [quot, rem] = std::div(steps, input.rows());
     int prevDist = 0;
     std::vector<int64_t> f;
     while (!q.empty()) {
@@ -90,20 +70,22 @@ int64_t part2(const Input& input, int steps) {
             prevDist = dist;
             if (prevDist == rem) {
                 f.push_back(q.size());
-                rem += (int)input.size();
+                rem += input.rows();
                 fmt::print("{} {}\n", dist, q.size());
             }
         }
         if (f.size() == 3) break;
         if (dist == steps) break;
         q.pop();
-        for (auto& [dr, dc] : std::array<std::pair<int, int>, 4>{{{-1, 0}, {0, 1}, {1, 0}, {0, -1}}})
-            if (const int nr = r + dr, nc = c + dc, rr = loop(nr, (int)input.size()),
-                cc = loop(nc, (int)input[0].size());
-                input[rr][cc] != '#' && visited[std::make_pair(nr, nc)] < dist + 1) {
-                visited[std::make_pair(nr, nc)] = dist + 1;
+        for (auto& [dr, dc] : std::array<std::pair<int, int>, 4>{{{-1, 0}, {0, 1}, {1, 0}, {0, -1}}}) {
+            const int nr = r + dr;
+            const int nc = c + dc;
+            if (input(loop(nr, input.rows()), loop(nc, input.cols())) == '#') continue;
+            if (int& seen = visited[{nr, nc}]; seen < dist + 1) {
+                seen = dist + 1;
                 q.emplace(nr, nc, dist + 1);
             }
+        }
     }
     /* Lagrange Quadratic Interpolation Using Basis Functions
 v0(x) = (x - x1)(x - x2) / (x0 - x1)(x0 - x2)
@@ -164,16 +146,8 @@ Let m = f1 - f0
     return a * quot * quot + b * quot + c;
 }
 
-std::pair<bool, bool> test() {
-    auto testPart1 = [](std::istream& is, int steps, int correctAnswer) {
-        const auto input = parseInput(is);
-        const int answer = part1(input, steps);
-        const bool correct = answer == correctAnswer;
-        fmt::print("Part 1: expected {}, got {}\n", correctAnswer,
-                   fmt::styled(answer, fmt::fg(correct ? fmt::color::green : fmt::color::red)));
-        return correct;
-    };
-    constexpr std::tuple<std::string_view, int, int> part1Cases[] = {{R"(
+std::vector<aoc::Sample> samples() {
+    constexpr std::string_view sample1{R"(
 ...........
 .....###.#.
 .###.##..#.
@@ -185,69 +159,18 @@ std::pair<bool, bool> test() {
 .##.#.####.
 .##..##.##.
 ...........
-)",
-                                                                      6, 16}};
-    bool part1Correct = true;
-    for (auto [sv, steps, correctAnswer] : part1Cases) {
-        std::istringstream iss{sv.data()};
-        iss.ignore();
-        part1Correct &= testPart1(iss, steps, correctAnswer);
-    }
-
-    auto testPart2 = [](std::istream& is, int steps, int64_t correctAnswer) {
-        const auto input = parseInput(is);
-        const auto answer = part2(input, steps);
-        const bool correct = answer == correctAnswer;
-        fmt::print("Part 2: expected {}, got {}\n", correctAnswer,
-                   fmt::styled(answer, fmt::fg(correct ? fmt::color::green : fmt::color::red)));
-        return correct;
+)"};
+    return {
+        aoc::makeSample(1, sample1, 16, parseInput, [](const Input& input) { return part1(input, 6); }),
+        aoc::makeSample(2, sample1, 5978 /*6536*/, parseInput, [](const Input& input) { return part2(input, 100); }),
     };
-    constexpr std::tuple<std::string_view, int, int64_t> part2Cases[] = {{R"(
-...........
-.....###.#.
-.###.##..#.
-..#.#...#..
-....#.#....
-.##..S####.
-.##..#...#.
-.......##..
-.##.#.####.
-.##..##.##.
-...........
-)",
-                                                                          100, 5978 /*6536*/}};
-    bool part2Correct = true;
-    for (auto [sv, steps, correctAnswer] : part2Cases) {
-        std::istringstream iss{sv.data()};
-        iss.ignore();
-        part2Correct &= testPart2(iss, steps, correctAnswer);
-    }
-    return {part1Correct, part2Correct};
 }
 
-int main() {
-    auto [test1, test2] = test();
-    if (!test1) return 1;
-    auto in = std::ifstream(kInputFilename.data());
-    if (!in) {
-        fmt::print("Cannot open '{}'\n", kInputFilename);
-        return -1;
-    }
-    const auto input = parseInput(in);
-
-    auto getTimeColor = [](const auto& elapsed) {
-        return elapsed < 100ms ? fmt::color::light_green : elapsed < 1s ? fmt::color::orange : fmt::color::orange_red;
-    };
-    auto startTime = cron::steady_clock::now();
-    const auto part1Ans = part1(input, 64);
-    cron::duration<double> elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 1: {} in {}\n", fmt::styled(part1Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
-
-    if (!test2) return 2;
-    startTime = cron::steady_clock::now();
-    const auto part2Ans = part2(input, 26501365);
-    elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 2: {} in {}\n", fmt::styled(part2Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+const aoc::Day& getDay() {
+    static const aoc::Day day = aoc::makeDay("day21", kInputFilename, samples(), parseInput,
+                                             [](const Input& input) { return part1(input, 64); },
+                                             [](const Input& input) { return part2(input, 26501365); });
+    return day;
 }
+
+} // namespace day21
@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day21
+{
+const aoc::Day& getDay();
+} // namespace day21
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day21::getDay(), argc, argv);
+}
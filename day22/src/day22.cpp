@@ -1,21 +1,22 @@
+#include <aoc/day.hpp>
+#include <aoc/flat_hash_map.hpp>
+#include <aoc/input.hpp>
+#include <aoc/scanner.hpp>
+#include <aoc/thread_pool.hpp>
+#include <aoc/trace.hpp>
 #include <fmt/format.h>
-#include <fmt/color.h>
 #include <fmt/ranges.h>
 #include <vector>
-#include <sstream>
-#include <fstream>
 #include <numeric>
 #include <algorithm>
-#include <unordered_map>
-#include <unordered_set>
-#include <stack>
+#include <functional>
 #include <ranges>
-#include <chrono>
-namespace cron = std::chrono;
-using namespace std::chrono_literals;
 namespace ranges = std::ranges;
 namespace views = std::views;
 
+namespace day22
+{
+
 static constexpr std::string_view kInputFilename = "day22.txt";
 
 struct Point3i {
@@ -40,25 +41,17 @@ struct Brick {
     int getMinZ() const { return std::min(from.z, to.z); }
 };
 
-size_t hashCombine(size_t seed, int val) {
-    return seed ^= std::hash<int>{}(val) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-}
-
-namespace std
-{
-template <>
-struct hash<Point3i> {
-    size_t operator()(const Point3i& p) const { return hashCombine(hashCombine(hashCombine(0, p.x), p.y), p.z); }
+struct Point3iHash {
+    size_t operator()(const Point3i& p) const { return aoc::hashValues(p.x, p.y, p.z); }
 };
-} // namespace std
 
 using Input = std::vector<Brick>;
 
-Input parseInput(std::istream& in) {
+Input parseInput(std::string_view text) {
     Input res;
     int brickId{};
-    for (std::string line; std::getline(in, line);) {
-        std::istringstream iss{line};
+    for (std::string_view line : aoc::splitLines(text)) {
+        aoc::Scanner iss{line};
         Brick brick;
         brick.id = brickId++;
         char ignore;
@@ -69,15 +62,16 @@ Input parseInput(std::istream& in) {
     return res;
 }
 
-std::pair<std::vector<std::unordered_set<int>>, std::vector<std::unordered_set<int>>> getBrickEqulibrium(Input input) {
-    std::unordered_map<Point3i, int> spaces;
+std::pair<std::vector<aoc::FlatHashSet<int>>, std::vector<aoc::FlatHashSet<int>>> getBrickEqulibrium(Input input) {
+    const aoc::TraceSpan span{"day22", "getBrickEqulibrium"};
+    aoc::FlatHashMap<Point3i, int, Point3iHash> spaces;
     for (auto& brick : input) brick.forEachBlock([&](const Point3i& p, int id) { spaces[p] = id; });
     ranges::sort(input, std::less{}, [](const Brick& brick) { return brick.getMinZ(); });
-    std::vector<std::unordered_set<int>> supportBy(input.size());
-    std::vector<std::unordered_set<int>> supports(input.size());
+    std::vector<aoc::FlatHashSet<int>> supportBy(input.size());
+    std::vector<aoc::FlatHashSet<int>> supports(input.size());
     for (auto& brick : input) {
         brick.forEachBlock([&](const Point3i& p, int) { spaces.erase(p); }); // temp removal
-        for (std::unordered_set<int> supp; brick.getMinZ() > 1;) {
+        for (aoc::FlatHashSet<int> supp; brick.getMinZ() > 1;) {
             --brick.from.z;
             --brick.to.z;
             brick.forEachBlock([&](const Point3i& p, int) {
@@ -103,38 +97,39 @@ int part1(const Input& input) {
     });
 }
 
+// Supporters left to every brick and the bricks falling, reused from one disintegration to the next
+struct Scratch {
+    std::vector<int> supportersLeft;
+    std::vector<int> falling;
+};
+
+// Each brick is disintegrated on its own, the chain reactions are spread over the shared thread pool
 int part2(const Input& input) {
     const auto [supports, supportBy] = getBrickEqulibrium(input);
-    int res{};
-    for (int brickId : views::iota(0, (int)input.size())) {
-        std::stack<int> st;
-        st.push(brickId);
-        auto supportBy2 = supportBy;
-        int cnt{-1};
-        while (!st.empty()) {
-            int id = st.top();
-            st.pop();
-            ++cnt;
-            for (int supportee : supports[id]) {
-                supportBy2[supportee].erase(id);
-                if (supportBy2[supportee].empty()) st.push(supportee);
+    aoc::PerWorker<Scratch> scratch;
+    return aoc::parallelReduce(
+        input.size(), 0,
+        [&](size_t brickId) {
+            auto& [supportersLeft, st] = scratch.local();
+            supportersLeft.resize(supportBy.size());
+            for (size_t id = 0; id < supportBy.size(); ++id)
+                supportersLeft[id] = static_cast<int>(supportBy[id].size());
+            st.assign(1, static_cast<int>(brickId));
+            int cnt{-1};
+            while (!st.empty()) {
+                int id = st.back();
+                st.pop_back();
+                ++cnt;
+                for (int supportee : supports[id])
+                    if (--supportersLeft[supportee] == 0) st.push_back(supportee);
             }
-        }
-        res += cnt;
-    }
-    return res;
+            return cnt;
+        },
+        std::plus{});
 }
 
-std::pair<bool, bool> test() {
-    auto testPart1 = [](std::istream& is, int correctAnswer) {
-        const auto input = parseInput(is);
-        const int answer = part1(input);
-        const bool correct = answer == correctAnswer;
-        fmt::print("Part 1: expected {}, got {}\n", correctAnswer,
-                   fmt::styled(answer, fmt::fg(correct ? fmt::color::green : fmt::color::red)));
-        return correct;
-    };
-    constexpr std::pair<std::string_view, int> part1Cases[] = {{R"(
+std::vector<aoc::Sample> samples() {
+    constexpr std::string_view sample1{R"(
 1,0,1~1,2,1
 0,0,2~2,0,2
 0,2,3~2,2,3
@@ -142,65 +137,16 @@ std::pair<bool, bool> test() {
 2,0,5~2,2,5
 0,1,6~2,1,6
 1,1,8~1,1,9
-)",
-                                                                5}};
-    bool part1Correct = true;
-    for (auto [sv, correctAnswer] : part1Cases) {
-        std::istringstream iss{sv.data()};
-        iss.ignore();
-        part1Correct &= testPart1(iss, correctAnswer);
-    }
-
-    auto testPart2 = [](std::istream& is, int correctAnswer) {
-        const auto input = parseInput(is);
-        const int answer = part2(input);
-        const bool correct = answer == correctAnswer;
-        fmt::print("Part 2: expected {}, got {}\n", correctAnswer,
-                   fmt::styled(answer, fmt::fg(correct ? fmt::color::green : fmt::color::red)));
-        return correct;
+)"};
+    return {
+        aoc::makeSample(1, sample1, 5, parseInput, part1),
+        aoc::makeSample(2, sample1, 7, parseInput, part2),
     };
-    constexpr std::pair<std::string_view, int> part2Cases[] = {{R"(
-1,0,1~1,2,1
-0,0,2~2,0,2
-0,2,3~2,2,3
-0,0,4~0,2,4
-2,0,5~2,2,5
-0,1,6~2,1,6
-1,1,8~1,1,9
-)",
-                                                                7}};
-    bool part2Correct = true;
-    for (auto [sv, correctAnswer] : part2Cases) {
-        std::istringstream iss{sv.data()};
-        iss.ignore();
-        part2Correct &= testPart2(iss, correctAnswer);
-    }
-    return {part1Correct, part2Correct};
 }
 
-int main() {
-    auto [test1, test2] = test();
-    if (!test1) return 1;
-    auto in = std::ifstream(kInputFilename.data());
-    if (!in) {
-        fmt::print("Cannot open '{}'\n", kInputFilename);
-        return -1;
-    }
-    const auto input = parseInput(in);
-
-    auto getTimeColor = [](const auto& elapsed) {
-        return elapsed < 100ms ? fmt::color::light_green : elapsed < 1s ? fmt::color::orange : fmt::color::orange_red;
-    };
-    auto startTime = cron::steady_clock::now();
-    const auto part1Ans = part1(input);
-    cron::duration<double> elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 1: {} in {}\n", fmt::styled(part1Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
-
-    if (!test2) return 2;
-    startTime = cron::steady_clock::now();
-    const auto part2Ans = part2(input);
-    elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 2: {} in {}\n", fmt::styled(part2Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+const aoc::Day& getDay() {
+    static const aoc::Day day = aoc::makeDay("day22", kInputFilename, samples(), parseInput, part1, part2);
+    return day;
 }
+
+} // namespace day22
@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day22
+{
+const aoc::Day& getDay();
+} // namespace day22
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day22::getDay(), argc, argv);
+}
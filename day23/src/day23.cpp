@@ -1,138 +1,132 @@
+#include <aoc/day.hpp>
+#include <aoc/graph.hpp>
+#include <aoc/grid.hpp>
+#include <aoc/input.hpp>
+#include <aoc/trace.hpp>
 #include <fmt/format.h>
-#include <fmt/color.h>
 #include <fmt/ranges.h>
 #include <vector>
-#include <sstream>
-#include <fstream>
+#include <string>
 #include <numeric>
 #include <algorithm>
 #include <ranges>
 #include <queue>
 #include <stack>
 #include <array>
-#include <unordered_map>
-#include <unordered_set>
-#include <chrono>
-namespace cron = std::chrono;
-using namespace std::chrono_literals;
 namespace ranges = std::ranges;
 namespace views = std::views;
 
+namespace day23
+{
+
 static constexpr std::string_view kInputFilename = "day23.txt";
 
-using Input = std::vector<std::string>;
+using Input = aoc::Grid<char>;
 
-Input parseInput(std::istream& in) {
-    Input res;
-    for (std::string line; std::getline(in, line);) res.push_back(line);
-    return res;
+// One cell of forest around the map, so the walks need no bounds checks
+Input parseInput(std::string_view text) {
+    return Input::fromLines(aoc::splitLines(text), 1, '#');
 }
 
 int part1(const Input& input) {
-    std::queue<std::tuple<int, size_t, size_t, size_t, size_t>> q;
-    std::vector<std::vector<int>> dists(input.size(), std::vector<int>(input[0].size()));
-    q.emplace(0, 0, 1, -1, -1);
+    const ptrdiff_t stride = input.stride();
+    std::queue<std::tuple<int, size_t, size_t>> q;
+    auto dists = aoc::Grid<int>::shapedLike(input);
+    q.emplace(0, input.index(0, 1), input.index(-1, 1));
     while (!q.empty()) {
-        auto [dist, r, c, fr, fc] = q.front();
+        auto [dist, cell, from] = q.front();
         q.pop();
-        dists[r][c] = dist;
-        if (input[r][c] == '.') {
-            for (auto [dr, dc] : std::array<std::pair<int, int>, 4>{{{-1, 0}, {0, 1}, {1, 0}, {0, -1}}})
-                if (const size_t nr = r + dr, nc = c + dc;
-                    nr < input.size() && nc < input[0].size() && (nr != fr || nc != fc) && input[nr][nc] != '#')
-                    q.emplace(dist + 1, nr, nc, r, c);
-        } else if (input[r][c] == '^') {
-            if (const size_t nr = r - 1, nc = c; nr < input.size() && nr != fr && input[nr][nc] != '#')
-                q.emplace(dist + 1, nr, nc, r, c);
-        } else if (input[r][c] == '>') {
-            if (const size_t nr = r, nc = c + 1; nc < input[0].size() && nc != fc && input[nr][nc] != '#')
-                q.emplace(dist + 1, nr, nc, r, c);
-        } else if (input[r][c] == 'v') {
-            if (const size_t nr = r + 1, nc = c; nr < input.size() && nr != fr && input[nr][nc] != '#')
-                q.emplace(dist + 1, nr, nc, r, c);
-        } else if (input[r][c] == '<') {
-            if (const size_t nr = r, nc = c - 1; nc < input[0].size() && nc != fc && input[nr][nc] != '#')
-                q.emplace(dist + 1, nr, nc, r, c);
+        dists[cell] = dist;
+        auto step = [&](ptrdiff_t offset) {
+            if (const size_t next = cell + offset; next != from && input[next] != '#') q.emplace(dist + 1, next, cell);
+        };
+        if (input[cell] == '.') {
+            for (ptrdiff_t offset : input.offsets4()) step(offset);
+        } else if (input[cell] == '^') {
+            step(-stride);
+        } else if (input[cell] == '>') {
+            step(1);
+        } else if (input[cell] == 'v') {
+            step(stride);
+        } else if (input[cell] == '<') {
+            step(-1);
         }
     }
-    return dists[input.size() - 1][input[0].size() - 2];
-}
-
-constexpr int kMult = 1000;
-
-int toInt(size_t r, size_t c) {
-    return (int)(r * kMult + c);
+    return dists(input.rows() - 1, input.cols() - 2);
 }
 
-std::pair<size_t, size_t> fromInt(int v) {
-    return {v / kMult, v % kMult};
-}
+// Junctions of the trails with the length of the paths between neighboring ones
+struct Junctions {
+    aoc::CsrGraph<> graph;
+    uint32_t start{};
+    uint32_t dest{};
+};
 
-std::unordered_map<int, std::vector<std::pair<int, int>>> parseAdjMap(const Input& input) {
-    std::unordered_map<int, std::vector<std::pair<int, int>>> res;
-    res[toInt(0, 1)];
-    res[toInt(input.size() - 1, input[0].size() - 2)];
-    for (size_t r = 0; r < input.size(); ++r) {
-        for (size_t c = 0; c < input[0].size(); ++c) {
-            if (input[r][c] == '#') continue;
-            int nbCnt{};
-            for (auto [dr, dc] : std::array<std::pair<int, int>, 4>{{{-1, 0}, {0, 1}, {1, 0}, {0, -1}}})
-                if (const size_t nr = r + dr, nc = c + dc;
-                    nr < input.size() && nc < input[0].size() && input[nr][nc] != '#')
-                    ++nbCnt;
-            if (nbCnt > 2) res[toInt(r, c)];
+Junctions parseAdjMap(const Input& input) {
+    const aoc::TraceSpan span{"day23", "parseAdjMap"};
+    // Vertex id of every junction cell, -1 elsewhere
+    auto ids = aoc::Grid<int>::shapedLike(input, -1, -1);
+    std::vector<size_t> cells;
+    auto addJunction = [&](size_t cell) {
+        ids[cell] = static_cast<int>(cells.size());
+        cells.push_back(cell);
+    };
+    addJunction(input.index(0, 1));
+    addJunction(input.index(input.rows() - 1, input.cols() - 2));
+    for (int r = 0; r < input.rows(); ++r) {
+        for (int c = 0; c < input.cols(); ++c) {
+            const size_t cell = input.index(r, c);
+            if (input[cell] == '#') continue;
+            const auto nbCnt = ranges::count_if(input.offsets4(), [&](ptrdiff_t offset) {
+                return input[cell + offset] != '#';
+            });
+            if (nbCnt > 2) addJunction(cell);
         }
     }
-    for (int k : res | views::keys) {
-        auto [sr, sc] = fromInt(k);
-        std::queue<std::tuple<size_t, size_t, int>> q;
-        std::unordered_set<int> visited;
-        q.emplace(sr, sc, 0);
-        visited.insert(toInt(sr, sc));
+    aoc::GraphBuilder<> builder{cells.size()};
+    auto visited = aoc::Grid<uint8_t>::shapedLike(input);
+    std::queue<std::pair<size_t, int>> q;
+    for (uint32_t from = 0; from < cells.size(); ++from) {
+        ranges::fill(visited.storage(), uint8_t{0});
+        q.emplace(cells[from], 0);
+        visited[cells[from]] = 1;
         while (!q.empty()) {
-            auto [r, c, dist] = q.front();
+            auto [cell, dist] = q.front();
             q.pop();
-            const int ki = toInt(r, c);
-            if (ki != k && res.count(ki) != 0) {
-                res[k].emplace_back(ki, dist);
+            if (cell != cells[from] && ids[cell] != -1) {
+                builder.addEdge(from, static_cast<uint32_t>(ids[cell]), dist);
                 continue;
             }
-            for (auto [dr, dc] : std::array<std::pair<int, int>, 4>{{{-1, 0}, {0, 1}, {1, 0}, {0, -1}}})
-                if (const size_t nr = r + dr, nc = c + dc;
-                    nr < input.size() && nc < input[0].size() && input[nr][nc] != '#') {
-                    const int vi = toInt(nr, nc);
-                    if (visited.count(vi) != 0) continue;
-                    q.emplace(nr, nc, dist + 1);
-                    visited.insert(vi);
+            for (ptrdiff_t offset : input.offsets4())
+                if (const size_t next = cell + offset; input[next] != '#' && !visited[next]) {
+                    q.emplace(next, dist + 1);
+                    visited[next] = 1;
                 }
         }
     }
-    return res;
+    return {builder.build(), 0, 1};
 }
 
-int part2(Input input) {
-    for (auto& row : input)
-        for (char& ch : row)
-            if (ch != '#') ch = '.';
-    auto adj = parseAdjMap(input);
+int part2(const Input& input) {
+    Input trails = input;
+    ranges::replace_if(trails.storage(), [](char ch) { return ch != '#'; }, '.');
+    const auto [graph, start, dest] = parseAdjMap(trails);
 
-    std::stack<std::pair<int, int>> st;
-    st.emplace(toInt(0, 1), 0);
-    std::unordered_set<int> visited;
-    const int dest = toInt(input.size() - 1, input[0].size() - 2);
+    std::stack<std::pair<uint32_t, int>> st;
+    st.emplace(start, 0);
+    std::vector<uint8_t> visited(graph.size());
     int res{};
     while (!st.empty()) {
         auto [k, dist] = st.top();
         st.pop();
         if (dist == -1) {
-            visited.erase(k);
+            visited[k] = 0;
             continue;
         }
-        visited.insert(k);
+        visited[k] = 1;
         st.emplace(k, -1);
-        for (auto& e : adj[k]) {
-            auto [kn, w] = e;
-            if (visited.count(kn) != 0) continue;
+        for (const auto& [kn, w] : graph.edges(k)) {
+            if (visited[kn]) continue;
             if (kn == dest) {
                 res = std::max(res, dist + w);
             } else {
@@ -143,16 +137,8 @@ int part2(Input input) {
     return res;
 }
 
-std::pair<bool, bool> test() {
-    auto testPart1 = [](std::istream& is, int correctAnswer) {
-        const auto input = parseInput(is);
-        const int answer = part1(input);
-        const bool correct = answer == correctAnswer;
-        fmt::print("Part 1: expected {}, got {}\n", correctAnswer,
-                   fmt::styled(answer, fmt::fg(correct ? fmt::color::green : fmt::color::red)));
-        return correct;
-    };
-    constexpr std::pair<std::string_view, int> part1Cases[] = {{R"(
+std::vector<aoc::Sample> samples() {
+    constexpr std::string_view sample1{R"(
 #.#####################
 #.......#########...###
 #######.#########.#.###
@@ -176,81 +162,16 @@ std::pair<bool, bool> test() {
 #.###.###.#.###.#.#v###
 #.....###...###...#...#
 #####################.#
-)",
-                                                                94}};
-    bool part1Correct = true;
-    for (auto [sv, correctAnswer] : part1Cases) {
-        std::istringstream iss{sv.data()};
-        iss.ignore();
-        part1Correct &= testPart1(iss, correctAnswer);
-    }
-
-    auto testPart2 = [](std::istream& is, int correctAnswer) {
-        const auto input = parseInput(is);
-        const int answer = part2(input);
-        const bool correct = answer == correctAnswer;
-        fmt::print("Part 2: expected {}, got {}\n", correctAnswer,
-                   fmt::styled(answer, fmt::fg(correct ? fmt::color::green : fmt::color::red)));
-        return correct;
+)"};
+    return {
+        aoc::makeSample(1, sample1, 94, parseInput, part1),
+        aoc::makeSample(2, sample1, 154, parseInput, part2),
     };
-    constexpr std::pair<std::string_view, int> part2Cases[] = {{R"(
-#.#####################
-#.......#########...###
-#######.#########.#.###
-###.....#.>.>.###.#.###
-###v#####.#v#.###.#.###
-###.>...#.#.#.....#...#
-###v###.#.#.#########.#
-###...#.#.#.......#...#
-#####.#.#.#######.#.###
-#.....#.#.#.......#...#
-#.#####.#.#.#########v#
-#.#...#...#...###...>.#
-#.#.#v#######v###.###v#
-#...#.>.#...>.>.#.###.#
-#####v#.#.###v#.#.###.#
-#.....#...#...#.#.#...#
-#.#########.###.#.#.###
-#...###...#...#...#.###
-###.###.#.###v#####v###
-#...#...#.#.>.>.#.>.###
-#.###.###.#.###.#.#v###
-#.....###...###...#...#
-#####################.#
-)",
-                                                                154}};
-    bool part2Correct = true;
-    for (auto [sv, correctAnswer] : part2Cases) {
-        std::istringstream iss{sv.data()};
-        iss.ignore();
-        part2Correct &= testPart2(iss, correctAnswer);
-    }
-    return {part1Correct, part2Correct};
 }
 
-int main() {
-    auto [test1, test2] = test();
-    if (!test1) return 1;
-    auto in = std::ifstream(kInputFilename.data());
-    if (!in) {
-        fmt::print("Cannot open '{}'\n", kInputFilename);
-        return -1;
-    }
-    const auto input = parseInput(in);
-
-    auto getTimeColor = [](const auto& elapsed) {
-        return elapsed < 100ms ? fmt::color::light_green : elapsed < 1s ? fmt::color::orange : fmt::color::orange_red;
-    };
-    auto startTime = cron::steady_clock::now();
-    const auto part1Ans = part1(input);
-    cron::duration<double> elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 1: {} in {}\n", fmt::styled(part1Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
-
-    if (!test2) return 2;
-    startTime = cron::steady_clock::now();
-    const auto part2Ans = part2(input);
-    elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 2: {} in {}\n", fmt::styled(part2Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+const aoc::Day& getDay() {
+    static const aoc::Day day = aoc::makeDay("day23", kInputFilename, samples(), parseInput, part1, part2);
+    return day;
 }
+
+} // namespace day23
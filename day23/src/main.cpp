@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day23
+{
+const aoc::Day& getDay();
+} // namespace day23
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day23::getDay(), argc, argv);
+}
@@ -1,23 +1,23 @@
+#include <aoc/day.hpp>
+#include <aoc/input.hpp>
+#include <aoc/scanner.hpp>
 #include <fmt/format.h>
-#include <fmt/color.h>
 #include <fmt/ranges.h>
 #include <vector>
-#include <sstream>
-#include <fstream>
 #include <numeric>
 #include <algorithm>
 #include <ranges>
-#include <chrono>
 #include <unordered_map>
 #include <unordered_set>
 #include <cmath>
-namespace cron = std::chrono;
-using namespace std::chrono_literals;
 namespace ranges = std::ranges;
 namespace views = std::views;
 #include <boost/multiprecision/cpp_int.hpp>
 using int128_t = boost::multiprecision::int128_t;
 
+namespace day24
+{
+
 static constexpr std::string_view kInputFilename = "day24.txt";
 
 struct Point3 {
@@ -33,10 +33,10 @@ struct Hailstone {
 
 using Input = std::vector<Hailstone>;
 
-Input parseInput(std::istream& in) {
+Input parseInput(std::string_view text) {
     Input res;
-    for (std::string line; std::getline(in, line);) {
-        std::istringstream iss{line};
+    for (std::string_view line : aoc::splitLines(text)) {
+        aoc::Scanner iss{line};
         Hailstone hs;
         char ignore;
         iss >> hs.pos.x >> ignore >> hs.pos.y >> ignore >> hs.pos.z >> ignore //
@@ -300,78 +300,25 @@ int64_t part2(Input input) {
     return 0;
 }
 
-std::pair<bool, bool> test() {
-    auto testPart1 = [](std::istream& is, int64_t i2, int64_t i3, int correctAnswer) {
-        const auto input = parseInput(is);
-        const int answer = part1(input, i2, i3);
-        const bool correct = answer == correctAnswer;
-        fmt::print("Part 1: expected {}, got {}\n", correctAnswer,
-                   fmt::styled(answer, fmt::fg(correct ? fmt::color::green : fmt::color::red)));
-        return correct;
-    };
-    constexpr std::tuple<std::string_view, int64_t, int64_t, int> part1Cases[] = {{R"(
+std::vector<aoc::Sample> samples() {
+    constexpr std::string_view sample1{R"(
 19, 13, 30 @ -2,  1, -2
 18, 19, 22 @ -1, -1, -2
 20, 25, 34 @ -2, -2, -4
 12, 31, 28 @ -1, -2, -1
 20, 19, 15 @  1, -5, -3
-)",
-                                                                                   7, 27, 2}};
-    bool part1Correct = true;
-    for (auto [sv, input2, input3, correctAnswer] : part1Cases) {
-        std::istringstream iss{sv.data()};
-        iss.ignore();
-        part1Correct &= testPart1(iss, input2, input3, correctAnswer);
-    }
-
-    auto testPart2 = [](std::istream& is, int64_t correctAnswer) {
-        const auto input = parseInput(is);
-        const int64_t answer = part2(input);
-        const bool correct = answer == correctAnswer;
-        fmt::print("Part 2: expected {}, got {}\n", correctAnswer,
-                   fmt::styled(answer, fmt::fg(correct ? fmt::color::green : fmt::color::red)));
-        return correct;
+)"};
+    return {
+        aoc::makeSample(1, sample1, 2, parseInput, [](const Input& input) { return part1(input, 7, 27); }),
+        aoc::makeSample(2, sample1, 47, parseInput, part2),
     };
-    constexpr std::pair<std::string_view, int64_t> part2Cases[] = {{R"(
-19, 13, 30 @ -2,  1, -2
-18, 19, 22 @ -1, -1, -2
-20, 25, 34 @ -2, -2, -4
-12, 31, 28 @ -1, -2, -1
-20, 19, 15 @  1, -5, -3
-)",
-                                                                    47}};
-    bool part2Correct = true;
-    for (auto [sv, correctAnswer] : part2Cases) {
-        std::istringstream iss{sv.data()};
-        iss.ignore();
-        part2Correct &= testPart2(iss, correctAnswer);
-    }
-    return {part1Correct, part2Correct};
 }
 
-int main() {
-    auto [test1, test2] = test();
-    if (!test1) return 1;
-    auto in = std::ifstream(kInputFilename.data());
-    if (!in) {
-        fmt::print("Cannot open '{}'\n", kInputFilename);
-        return -1;
-    }
-    const auto input = parseInput(in);
-
-    auto getTimeColor = [](const auto& elapsed) {
-        return elapsed < 100ms ? fmt::color::light_green : elapsed < 1s ? fmt::color::orange : fmt::color::orange_red;
-    };
-    auto startTime = cron::steady_clock::now();
-    const auto part1Ans = part1(input, 200000000000000LL, 400000000000000LL);
-    cron::duration<double> elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 1: {} in {}\n", fmt::styled(part1Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
-
-    if (!test2) return 2;
-    startTime = cron::steady_clock::now();
-    const auto part2Ans = part2(input);
-    elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 2: {} in {}\n", fmt::styled(part2Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+const aoc::Day& getDay() {
+    static const aoc::Day day = aoc::makeDay(
+        "day24", kInputFilename, samples(), parseInput,
+        [](const Input& input) { return part1(input, 200000000000000LL, 400000000000000LL); }, part2);
+    return day;
 }
+
+} // namespace day24
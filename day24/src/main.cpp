@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day24
+{
+const aoc::Day& getDay();
+} // namespace day24
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day24::getDay(), argc, argv);
+}
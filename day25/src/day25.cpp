@@ -1,148 +1,164 @@
+#include <aoc/day.hpp>
+#include <aoc/graph.hpp>
+#include <aoc/input.hpp>
+#include <aoc/scanner.hpp>
+#include <aoc/thread_pool.hpp>
+#include <aoc/trace.hpp>
 #include <fmt/format.h>
-#include <fmt/color.h>
 #include <fmt/ranges.h>
 #include <vector>
-#include <sstream>
-#include <fstream>
+#include <memory_resource>
+#include <optional>
+#include <string>
 #include <numeric>
 #include <algorithm>
-#include <chrono>
-#include <unordered_map>
-#include <unordered_set>
-#include <stack>
+#include <tuple>
 #include <random>
 #include <cmath>
-namespace cron = std::chrono;
-using namespace std::chrono_literals;
-#include <range/v3/algorithm.hpp>
-#include <range/v3/view.hpp>
-namespace views = ranges::views;
+#include <ranges>
+namespace ranges = std::ranges;
+
+namespace day25
+{
 
 static constexpr std::string_view kInputFilename = "day25.txt";
 
-std::mt19937 prbg{1};
+// fastmincut recursion levels shown in a trace, the deeper ones are too many and too short to read on a timeline
+constexpr int kTracedLevels = 6;
 
+// Multigraph being contracted: parallel edges are one edge weighted by their count, and every vertex stands for the
+// group of original vertices merged into it
 struct Input {
-    std::vector<size_t> vertices;
-    std::unordered_map<size_t, std::unordered_map<size_t, int>> adj;
-    size_t edgeCount{0};
-    std::vector<int> vertexGroupSizes;
+    aoc::CsrGraph<> graph;
+    std::pmr::vector<int> vertexGroupSizes;
+    size_t edgeCount{0}; // sum of the weights of the undirected edges
 
-    Input fastmincut() const {
-        if (vertices.size() <= 6) return contract(2);
-        const auto t = static_cast<size_t>(std::ceil(1 + vertices.size() / std::sqrt(2)));
-        Input g1 = contract(t).fastmincut();
-        Input g2 = contract(t).fastmincut();
-        return g1.edgeCount < g2.edgeCount ? g1 : g2;
+    Input fastmincut(std::mt19937& rng, std::pmr::memory_resource* arena, int level = 0) const {
+        std::optional<aoc::TraceSpan> span;
+        if (level < kTracedLevels) span.emplace("day25", "fastmincut", "level", level);
+        if (graph.size() <= 6) return contract(2, rng, arena);
+        const auto t = static_cast<size_t>(std::ceil(1 + graph.size() / std::sqrt(2)));
+        Input g1 = contract(t, rng, arena).fastmincut(rng, arena, level + 1);
+        Input g2 = contract(t, rng, arena).fastmincut(rng, arena, level + 1);
+        return g1.edgeCount < g2.edgeCount ? std::move(g1) : std::move(g2);
     }
 
 private:
-    Input contract(size_t t) const {
-        Input res = *this;
-        while (res.vertices.size() > t) res.removeRandomEdge();
-        return res;
-    }
-    void removeRandomEdge() {
-        // pop random edge
-        size_t u{};
-        size_t v{};
-        auto pop1 = [&] {
-            const size_t uid = std::uniform_int_distribution<size_t>{0, vertices.size() - 1}(prbg);
-            std::swap(vertices[uid], vertices.back());
-            const auto u = vertices.back();
-            vertices.pop_back();
-            return u;
+    // Merges the endpoints of random edges until `t` vertices are left
+    Input contract(size_t t, std::mt19937& rng, std::pmr::memory_resource* arena) const {
+        // Sorting the edges by exponential keys of rate weight draws them in turn with probability proportional to
+        // their weight, the edges made self-loops by earlier merges are skipped like they are removed
+        std::pmr::vector<std::pair<double, std::pair<uint32_t, uint32_t>>> order{arena};
+        order.reserve(graph.edgeCount() / 2);
+        for (uint32_t u = 0; u < graph.size(); ++u)
+            for (const auto& [v, w] : graph.edges(u))
+                if (u < v)
+                    order.push_back({std::exponential_distribution<double>{static_cast<double>(w)}(rng), {u, v}});
+        ranges::sort(order, std::less{}, [](const auto& keyed) { return keyed.first; });
+
+        std::pmr::vector<uint32_t> parent{graph.size(), arena};
+        std::iota(begin(parent), end(parent), 0u);
+        auto root = [&](uint32_t v) {
+            while (parent[v] != v) v = parent[v] = parent[parent[v]];
+            return v;
         };
-        for (;;) {
-            u = pop1();
-            v = pop1();
-            if (adj[u].count(v) > 0) break;
-            vertices.push_back(u);
-            vertices.push_back(v);
+        size_t vertexCount = graph.size();
+        for (auto it = begin(order); vertexCount > t && it != end(order); ++it) {
+            const uint32_t ru = root(it->second.first);
+            const uint32_t rv = root(it->second.second);
+            if (ru == rv) continue;
+            parent[ru] = rv;
+            --vertexCount;
+        }
+
+        Input res;
+        res.vertexGroupSizes = std::pmr::vector<int>(vertexCount, 0, arena);
+        std::pmr::vector<uint32_t> ids{graph.size(), UINT32_MAX, arena};
+        uint32_t nextId{};
+        for (uint32_t v = 0; v < graph.size(); ++v) {
+            uint32_t& id = ids[root(v)];
+            if (id == UINT32_MAX) id = nextId++;
+            res.vertexGroupSizes[id] += vertexGroupSizes[v];
         }
-        // remove from adj
-        const auto adju = std::move(adj[u]);
-        const auto adjv = std::move(adj[v]);
-        adj.erase(u);
-        adj.erase(v);
-        // insert uv
-        const auto uv = vertexGroupSizes.size();
-        const auto uvSize = vertexGroupSizes[u] + vertexGroupSizes[v];
-        vertices.push_back(uv);
-        vertexGroupSizes.push_back(uvSize);
-        for (auto& [k, w] : adju) {
-            if (k == v) continue;
-            adj[k].erase(u);
-            adj[k][uv] += w;
-            adj[uv][k] += w;
+        // Edges between groups, parallel ones summed
+        std::pmr::vector<std::tuple<uint32_t, uint32_t, int>> edges{arena};
+        for (uint32_t u = 0; u < graph.size(); ++u) {
+            for (const auto& [v, w] : graph.edges(u)) {
+                const uint32_t iu = ids[root(u)];
+                const uint32_t iv = ids[root(v)];
+                if (iu < iv) edges.emplace_back(iu, iv, w);
+            }
         }
-        for (auto& [k, w] : adjv) {
-            if (k == u) continue;
-            adj[k].erase(v);
-            adj[k][uv] += w;
-            adj[uv][k] += w;
+        ranges::sort(edges);
+        aoc::GraphBuilder<> builder{vertexCount};
+        for (auto it = begin(edges); it != end(edges);) {
+            const auto [u, v, w] = *it;
+            int weight{};
+            for (; it != end(edges) && std::get<0>(*it) == u && std::get<1>(*it) == v; ++it) weight += std::get<2>(*it);
+            builder.addUndirectedEdge(u, v, weight);
+            res.edgeCount += weight;
         }
-        edgeCount -= adju.at(v);
+        res.graph = builder.build(arena);
+        return res;
     }
 };
 
-Input parseInput(std::istream& in) {
-    Input res;
-    std::unordered_map<std::string, size_t> m;
-    auto getId = [&](const std::string& s) {
-        if (auto it = m.find(s); it != end(m)) {
-            return it->second;
-        } else {
-            auto [jt, ok] = m.emplace(s, m.size());
-            return jt->second;
-        }
-    };
-    for (std::string line; std::getline(in, line);) {
-        std::istringstream iss{line};
-        std::string from;
+Input parseInput(std::string_view text, std::pmr::memory_resource* arena) {
+    aoc::GraphBuilder<> builder;
+    for (std::string_view line : aoc::splitLines(text)) {
+        aoc::Scanner iss{line};
+        std::string_view from;
         iss >> from;
-        from.pop_back();
-        size_t fromId = getId(from);
-        for (std::string to; iss >> to;) {
-            size_t toId = getId(to);
-            res.adj[fromId][toId] = 1;
-            res.adj[toId][fromId] = 1;
-        }
+        from.remove_suffix(1);
+        const uint32_t fromId = builder.vertex(from);
+        for (std::string_view to; iss >> to;) builder.addUndirectedEdge(fromId, builder.vertex(to));
     }
-    res.vertices = res.adj | views::keys | ranges::to<std::vector>();
-    res.vertexGroupSizes.resize(res.vertices.size(), 1);
-    for (auto& [k, adjk] : res.adj) res.edgeCount += ranges::fold_left(adjk | views::values, 0LL, std::plus{});
-    res.edgeCount /= 2;
-    fmt::print("|V| = {}, |E| = {}\n", res.vertices.size(), res.edgeCount);
+    Input res;
+    res.graph = builder.build(arena);
+    res.vertexGroupSizes = std::pmr::vector<int>(res.graph.size(), 1, arena);
+    res.edgeCount = res.graph.edgeCount() / 2;
+    fmt::print("|V| = {}, |E| = {}\n", res.graph.size(), res.edgeCount);
     return res;
 }
 
+struct Trial {
+    size_t vertexCount{};
+    size_t edgeCount{};
+    int groupSize1{};
+    int groupSize2{};
+};
+
+// Trials are independent and run a round of one per worker at a time. Each has its own generator seeded with its
+// number, so the trials printed and the one that wins do not depend on the scheduling.
 int part1(const Input& input) {
-    for (size_t t = 1; t < 100; ++t) {
-        const auto g = input.fastmincut();
-        fmt::print("trial {}: |V| = {}, |E| = {}\n", t, g.vertices.size(), g.edgeCount);
-        if (g.edgeCount == 3) {
-            fmt::print("{} {}\n", g.vertexGroupSizes[g.vertices[0]], g.vertexGroupSizes[g.vertices[1]]);
-            return (int)(g.vertexGroupSizes[g.vertices[0]] * g.vertexGroupSizes[g.vertices[1]]);
+    constexpr size_t kTrials = 99;
+    // A pool without workers runs the round on this thread
+    const size_t roundSize = std::max<size_t>(aoc::ThreadPool::shared().size(), 1);
+    for (size_t first = 1; first <= kTrials; first += roundSize) {
+        std::vector<Trial> trials(std::min(roundSize, kTrials + 1 - first));
+        aoc::parallelFor(trials.size(), [&](size_t i) {
+            std::mt19937 rng{static_cast<std::mt19937::result_type>(first + i)};
+            // Every contraction builds a smaller graph that is dropped soon after and a trial does that many times
+            // over, a monotonic arena would keep all of them. The pool recycles them and still releases everything at
+            // once.
+            std::pmr::unsynchronized_pool_resource pool;
+            const auto g = input.fastmincut(rng, &pool);
+            trials[i] = {g.graph.size(), g.edgeCount, g.vertexGroupSizes[0], g.vertexGroupSizes[1]};
+        });
+        for (size_t i = 0; i < trials.size(); ++i) {
+            const Trial& trial = trials[i];
+            fmt::print("trial {}: |V| = {}, |E| = {}\n", first + i, trial.vertexCount, trial.edgeCount);
+            if (trial.edgeCount == 3) {
+                fmt::print("{} {}\n", trial.groupSize1, trial.groupSize2);
+                return trial.groupSize1 * trial.groupSize2;
+            }
         }
     }
     return -1;
 }
 
-int part2(const Input& input) {
-    return static_cast<int>(input.vertices.size());
-}
-
-std::pair<bool, bool> test() {
-    auto testPart1 = [](std::istream& is, int correctAnswer) {
-        const auto input = parseInput(is);
-        const int answer = part1(input);
-        const bool correct = answer == correctAnswer;
-        fmt::print("Part 1: expected {}, got {}\n", correctAnswer,
-                   fmt::styled(answer, fmt::fg(correct ? fmt::color::green : fmt::color::red)));
-        return correct;
-    };
-    constexpr std::pair<std::string_view, int> part1Cases[] = {{R"(
+std::vector<aoc::Sample> samples() {
+    constexpr std::string_view sample1{R"(
 jqt: rhn xhk nvd
 rsh: frs pzl lsr
 xhk: hfx
@@ -156,40 +172,15 @@ nvd: lhk
 lsr: lhk
 rzs: qnr cmg lsr rsh
 frs: qnr lhk lsr
-)",
-                                                                54}};
-    bool part1Correct = true;
-    for (auto [sv, correctAnswer] : part1Cases) {
-        std::istringstream iss{sv.data()};
-        iss.ignore();
-        part1Correct &= testPart1(iss, correctAnswer);
-    }
-    return {part1Correct, 0};
-}
-
-int main() {
-    auto [test1, test2] = test();
-    if (!test1) return 1;
-    auto in = std::ifstream(kInputFilename.data());
-    if (!in) {
-        fmt::print("Cannot open '{}'\n", kInputFilename);
-        return -1;
-    }
-    const auto input = parseInput(in);
-
-    auto getTimeColor = [](const auto& elapsed) {
-        return elapsed < 100ms ? fmt::color::light_green : elapsed < 1s ? fmt::color::orange : fmt::color::orange_red;
+)"};
+    return {
+        aoc::makeSample(1, sample1, 54, parseInput, part1),
     };
-    auto startTime = cron::steady_clock::now();
-    const auto part1Ans = part1(input);
-    cron::duration<double> elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 1: {} in {}\n", fmt::styled(part1Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+}
 
-    if (!test2) return 2;
-    startTime = cron::steady_clock::now();
-    const auto part2Ans = part2(input);
-    elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 2: {} in {}\n", fmt::styled(part2Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+const aoc::Day& getDay() {
+    static const aoc::Day day = aoc::makeDay("day25", kInputFilename, samples(), parseInput, part1);
+    return day;
 }
+
+} // namespace day25
@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day25
+{
+const aoc::Day& getDay();
+} // namespace day25
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day25::getDay(), argc, argv);
+}
@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day3
+{
+const aoc::Day& getDay();
+} // namespace day3
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day3::getDay(), argc, argv);
+}
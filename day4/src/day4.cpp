@@ -1,65 +1,117 @@
+#include <aoc/day.hpp>
+#include <aoc/input.hpp>
+#include <aoc/scanner.hpp>
 #include <fmt/format.h>
-#include <fmt/color.h>
 #include <vector>
-#include <sstream>
-#include <fstream>
+#include <deque>
+#include <memory_resource>
+#include <string>
 #include <numeric>
 #include <algorithm>
 #include <ranges>
-#include <chrono>
-namespace cron = std::chrono;
-using namespace std::chrono_literals;
 namespace ranges = std::ranges;
 namespace views = std::views;
 
+namespace day4
+{
+
 static constexpr std::string_view kInputFilename = "day4.txt";
 
 struct Card {
-    std::vector<int> winningNumbers;
-    std::vector<int> myNumbers;
+    std::pmr::vector<int> winningNumbers;
+    std::pmr::vector<int> myNumbers;
 };
 
-using Input = std::vector<Card>;
-
-Input parseInput(std::istream& in) {
-    Input res;
-    for (std::string line; std::getline(in, line);) {
-        std::istringstream lineStream{line};
-        Card card;
-        std::string tok;
-        lineStream >> tok >> tok;
-        for (; lineStream >> tok && tok[0] != '|';) card.winningNumbers.push_back(std::stoi(tok));
-        for (int n; lineStream >> n;) card.myNumbers.push_back(n);
+using Input = std::pmr::vector<Card>;
+
+// Fills `card` from its line "Card 1: 41 48 83 | 83 86  6"
+void parseCard(std::string_view line, Card& card) {
+    aoc::Scanner lineStream{line};
+    card.winningNumbers.clear();
+    card.myNumbers.clear();
+    std::string_view tok;
+    lineStream >> tok >> tok;
+    for (; lineStream >> tok && tok[0] != '|';) card.winningNumbers.push_back(aoc::parseInt(tok));
+    for (int n; lineStream >> n;) card.myNumbers.push_back(n);
+}
+
+Input parseInput(std::string_view text, std::pmr::memory_resource* arena) {
+    Input res{arena};
+    for (std::string_view line : aoc::splitLines(text)) {
+        Card card{std::pmr::vector<int>{arena}, std::pmr::vector<int>{arena}};
+        parseCard(line, card);
         res.emplace_back(std::move(card));
     }
     return res;
 }
 
-int part1(const Input& input) {
-    return std::transform_reduce(begin(input), end(input), 0, std::plus{}, [](Card card) {
-        ranges::sort(card.winningNumbers);
-        ranges::sort(card.myNumbers);
-        std::vector<int> intersections;
-        ranges::set_intersection(card.winningNumbers, card.myNumbers, std::back_inserter(intersections));
-        return 1 << (intersections.size() - 1);
+// Sorted copies of both lists and their intersection, reused from card to card
+struct MatchScratch {
+    std::pmr::vector<int> winningNumbers;
+    std::pmr::vector<int> myNumbers;
+    std::pmr::vector<int> intersections;
+
+    explicit MatchScratch(std::pmr::memory_resource* arena)
+    : winningNumbers{arena}, myNumbers{arena}, intersections{arena} {}
+
+    size_t countMatches(const Card& card) {
+        winningNumbers.assign(begin(card.winningNumbers), end(card.winningNumbers));
+        myNumbers.assign(begin(card.myNumbers), end(card.myNumbers));
+        ranges::sort(winningNumbers);
+        ranges::sort(myNumbers);
+        intersections.clear();
+        ranges::set_intersection(winningNumbers, myNumbers, std::back_inserter(intersections));
+        return intersections.size();
+    }
+};
+
+int part1(const Input& input, std::pmr::memory_resource* arena) {
+    MatchScratch scratch{arena};
+    return std::transform_reduce(begin(input), end(input), 0, std::plus{}, [&](const Card& card) {
+        const size_t matches = scratch.countMatches(card);
+        return matches == 0 ? 0 : 1 << (matches - 1);
     });
 }
 
-int part2(const Input& input) {
-    std::vector<int> cardCount(input.size(), 1);
-    for (size_t cardId = 0; Card card : input) {
-        ranges::sort(card.winningNumbers);
-        ranges::sort(card.myNumbers);
-        std::vector<int> intersections;
-        ranges::set_intersection(card.winningNumbers, card.myNumbers, std::back_inserter(intersections));
-        for (size_t i = cardId + 1; i <= cardId + intersections.size(); ++i) cardCount[i] += cardCount[cardId];
+int part2(const Input& input, std::pmr::memory_resource* arena) {
+    MatchScratch scratch{arena};
+    std::pmr::vector<int> cardCount(input.size(), 1, arena);
+    for (size_t cardId = 0; const Card& card : input) {
+        const size_t matches = scratch.countMatches(card);
+        for (size_t i = cardId + 1; i <= cardId + matches; ++i) cardCount[i] += cardCount[cardId];
         ++cardId;
     }
     return ranges::fold_left(cardCount, 0, std::plus{});
 }
 
-std::pair<bool, bool> test() {
-    std::istringstream iss1{R"(
+// Both totals card by card, for --stream. Only the copies won of the next cards are kept, as many as the most matches
+// of a card.
+struct Fold {
+    Card card;
+    MatchScratch scratch{std::pmr::get_default_resource()};
+    std::deque<int> extraCopies;
+    int sum1{};
+    int sum2{};
+
+    void add(std::string_view line) {
+        parseCard(line, card);
+        const size_t matches = scratch.countMatches(card);
+        sum1 += matches == 0 ? 0 : 1 << (matches - 1);
+        int count = 1;
+        if (!extraCopies.empty()) {
+            count += extraCopies.front();
+            extraCopies.pop_front();
+        }
+        sum2 += count;
+        if (extraCopies.size() < matches) extraCopies.resize(matches);
+        for (size_t i = 0; i < matches; ++i) extraCopies[i] += count;
+    }
+    int part1() const { return sum1; }
+    int part2() const { return sum2; }
+};
+
+std::vector<aoc::Sample> samples() {
+    constexpr std::string_view sample1{R"(
 Card 1: 41 48 83 86 17 | 83 86  6 31 17  9 48 53
 Card 2: 13 32 20 16 61 | 61 30 68 82 17 32 24 19
 Card 3:  1 21 53 59 44 | 69 82 63 72 16 21 14  1
@@ -67,47 +119,16 @@ Card 4: 41 92 73 84 69 | 59 84 76 51 58  5 54 83
 Card 5: 87 83 26 28 32 | 88 30 70 12 93 22 82 36
 Card 6: 31 18 13 56 72 | 74 77 10 23 35 67 36 11
 )"};
-    iss1.ignore();
-    const auto input1 = parseInput(iss1);
-
-    constexpr int part1CorrectAnswer = 13;
-    const int part1Answer = part1(input1);
-    const bool part1Correct = part1Answer == part1CorrectAnswer;
-    fmt::print("Part 1: expected {}, got {}\n", part1CorrectAnswer,
-               fmt::styled(part1Answer, fmt::fg(part1Correct ? fmt::color::green : fmt::color::red)));
-
-    constexpr int part2CorrectAnswer = 30;
-    const int part2Answer = part2(input1);
-    const bool part2Correct = part2Answer == part2CorrectAnswer;
-    fmt::print("Part 2: expected {}, got {}\n", part2CorrectAnswer,
-               fmt::styled(part2Answer, fmt::fg(part2Correct ? fmt::color::green : fmt::color::red)));
-
-    return {part1Correct, part2Correct};
+    return {
+        aoc::makeSample(1, sample1, 13, parseInput, part1),
+        aoc::makeSample(2, sample1, 30, parseInput, part2),
+    };
 }
 
-int main() {
-    auto [test1, test2] = test();
-    if (!test1) return 1;
-    auto in = std::ifstream(kInputFilename.data());
-    if (!in) {
-        fmt::print("Cannot open '{}'\n", kInputFilename);
-        return -1;
-    }
-    const auto input = parseInput(in);
-
-    auto getTimeColor = [](const auto& elapsed) {
-        return elapsed < 100ms ? fmt::color::light_green : elapsed < 1s ? fmt::color::orange : fmt::color::orange_red;
-    };
-    auto startTime = cron::steady_clock::now();
-    const auto part1Ans = part1(input);
-    cron::duration<double> elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 1: {} in {}\n", fmt::styled(part1Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
-
-    if (!test2) return 2;
-    startTime = cron::steady_clock::now();
-    const auto part2Ans = part2(input);
-    elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 2: {} in {}\n", fmt::styled(part2Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+const aoc::Day& getDay() {
+    static const aoc::Day day =
+        aoc::withStream<Fold>(aoc::makeDay("day4", kInputFilename, samples(), parseInput, part1, part2));
+    return day;
 }
+
+} // namespace day4
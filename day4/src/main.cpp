@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day4
+{
+const aoc::Day& getDay();
+} // namespace day4
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day4::getDay(), argc, argv);
+}
@@ -1,9 +1,10 @@
+#include <aoc/day.hpp>
+#include <aoc/input.hpp>
+#include <aoc/scanner.hpp>
 #include <fmt/format.h>
-#include <fmt/color.h>
 #include <fmt/ranges.h>
 #include <vector>
-#include <sstream>
-#include <fstream>
+#include <string>
 #include <numeric>
 #include <algorithm>
 #include <ranges>
@@ -14,12 +15,12 @@
 #include <tuple>
 #include <optional>
 #include <utility>
-#include <chrono>
-namespace cron = std::chrono;
-using namespace std::chrono_literals;
 namespace ranges = std::ranges;
 namespace views = std::views;
 
+namespace day5
+{
+
 static constexpr std::string_view kInputFilename = "day5.txt";
 
 struct ClosedInterval {
@@ -66,21 +67,19 @@ struct Input {
     std::array<std::vector<CITransf>, 7> mapping;
 };
 
-Input parseInput(std::istream& in) {
+Input parseInput(std::string_view text) {
     Input res;
-    std::string line;
-    std::getline(in, line);
-    if (std::istringstream iss{line}) {
-        iss >> line;
+    const auto lines = aoc::splitLines(text);
+    if (lines.empty()) return res;
+    if (aoc::Scanner iss{lines[0]}) {
+        iss.expect("seeds:");
         for (int64_t n; iss >> n;) res.seeds.push_back(n);
     }
-    std::getline(in, line);
+    size_t i = 1; // empty line after the seeds
     for (auto& m : res.mapping) {
-        std::getline(in, line);
-        for (; std::getline(in, line) && !line.empty();) {
+        for (i += 2; i < lines.size() && !lines[i].empty(); ++i) { // skip empty line and "x-to-y map:"
             int64_t to, from, len;
-            std::istringstream iss{line};
-            iss >> to >> from >> len;
+            aoc::Scanner{lines[i]} >> to >> from >> len;
             ClosedInterval ci{from, from + len - 1};
             m.emplace_back(ci, to - from);
         }
@@ -122,8 +121,8 @@ int64_t part2(const Input& input) {
     return ranges::min(seeds | views::transform([](const auto& ci) { return ci.a; }));
 }
 
-std::pair<bool, bool> test() {
-    std::istringstream iss1{R"(
+std::vector<aoc::Sample> samples() {
+    constexpr std::string_view sample1{R"(
 seeds: 79 14 55 13
 
 seed-to-soil map:
@@ -158,47 +157,15 @@ humidity-to-location map:
 60 56 37
 56 93 4
 )"};
-    iss1.ignore();
-    const auto input1 = parseInput(iss1);
-
-    constexpr int64_t part1CorrectAnswer = 35;
-    const auto part1Answer = part1(input1);
-    const bool part1Correct = part1Answer == part1CorrectAnswer;
-    fmt::print("Part 1: expected {}, got {}\n", part1CorrectAnswer,
-               fmt::styled(part1Answer, fmt::fg(part1Correct ? fmt::color::green : fmt::color::red)));
-
-    constexpr int64_t part2CorrectAnswer = 46;
-    const auto part2Answer = part2(input1);
-    const bool part2Correct = part2Answer == part2CorrectAnswer;
-    fmt::print("Part 2: expected {}, got {}\n", part2CorrectAnswer,
-               fmt::styled(part2Answer, fmt::fg(part2Correct ? fmt::color::green : fmt::color::red)));
-
-    return {part1Correct, part2Correct};
+    return {
+        aoc::makeSample(1, sample1, 35, parseInput, part1),
+        aoc::makeSample(2, sample1, 46, parseInput, part2),
+    };
 }
 
-int main() {
-    auto [test1, test2] = test();
-    if (!test1) return 1;
-    auto in = std::ifstream(kInputFilename.data());
-    if (!in) {
-        fmt::print("Cannot open '{}'\n", kInputFilename);
-        return -1;
-    }
-    const auto input = parseInput(in);
-
-    auto getTimeColor = [](const auto& elapsed) {
-        return elapsed < 100ms ? fmt::color::light_green : elapsed < 1s ? fmt::color::orange : fmt::color::orange_red;
-    };
-    auto startTime = cron::steady_clock::now();
-    const auto part1Ans = part1(input);
-    cron::duration<double> elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 1: {} in {}\n", fmt::styled(part1Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
-
-    if (!test2) return 2;
-    startTime = cron::steady_clock::now();
-    const auto part2Ans = part2(input);
-    elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 2: {} in {}\n", fmt::styled(part2Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+const aoc::Day& getDay() {
+    static const aoc::Day day = aoc::makeDay("day5", kInputFilename, samples(), parseInput, part1, part2);
+    return day;
 }
+
+} // namespace day5
@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day5
+{
+const aoc::Day& getDay();
+} // namespace day5
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day5::getDay(), argc, argv);
+}
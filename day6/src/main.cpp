@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day6
+{
+const aoc::Day& getDay();
+} // namespace day6
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day6::getDay(), argc, argv);
+}
@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day7
+{
+const aoc::Day& getDay();
+} // namespace day7
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day7::getDay(), argc, argv);
+}
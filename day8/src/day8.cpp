@@ -1,60 +1,71 @@
+#include <aoc/day.hpp>
+#include <aoc/graph.hpp>
+#include <aoc/input.hpp>
+#include <aoc/scanner.hpp>
 #include <fmt/format.h>
-#include <fmt/color.h>
 #include <vector>
-#include <sstream>
-#include <fstream>
+#include <string>
 #include <numeric>
 #include <algorithm>
 #include <ranges>
-#include <unordered_map>
-#include <stdexcept>
-#include <chrono>
-namespace cron = std::chrono;
-using namespace std::chrono_literals;
 namespace ranges = std::ranges;
 namespace views = std::views;
-using namespace std::string_literals;
+
+namespace day8
+{
 
 static constexpr std::string_view kInputFilename = "day8.txt";
 
+// Every node has its left edge first and its right edge second
 struct Input {
-    std::string instrs;
-    std::unordered_map<std::string, std::pair<std::string, std::string>> adj;
+    std::string_view instrs;
+    aoc::CsrGraph<> graph;
 };
 
-Input parseInput(std::istream& in) {
+Input parseInput(std::string_view text) {
+    aoc::Scanner in{text};
     Input res;
     in >> res.instrs;
-    for (std::string from, ignore, to1, to2; in >> from >> ignore >> to1 >> to2;)
-        res.adj[from] = std::make_pair(to1.substr(1, 3), to2.substr(0, 3));
+    aoc::GraphBuilder<> builder;
+    for (std::string_view from, ignore, to1, to2; in >> from >> ignore >> to1 >> to2;) {
+        const uint32_t fromId = builder.vertex(from);
+        builder.addEdge(fromId, builder.vertex(to1.substr(1, 3)));
+        builder.addEdge(fromId, builder.vertex(to2.substr(0, 3)));
+    }
+    res.graph = builder.build();
     return res;
 }
 
-int part1(const Input& input, std::string s = "AAA") {
-    return 1 + *(views::iota(0) | views::drop_while([&](int i) {
-                     return "ZZZ" != (s = input.instrs[i % input.instrs.size()] == 'L'
-                                              ? input.adj.find(s)->second.first
-                                              : input.adj.find(s)->second.second);
-                 })).begin();
+// Steps from `node` until a node for which isEnd() holds
+template <class IsEnd>
+int countSteps(const Input& input, uint32_t node, IsEnd isEnd) {
+    int steps{};
+    do {
+        node = input.graph.edges(node)[input.instrs[steps % input.instrs.size()] == 'L' ? 0 : 1].to;
+        ++steps;
+    } while (!isEnd(node));
+    return steps;
+}
+
+int part1(const Input& input) {
+    const uint32_t end = *input.graph.find("ZZZ");
+    return countSteps(input, *input.graph.find("AAA"), [&](uint32_t node) { return node == end; });
 }
 
 int64_t part2(const Input& input) {
-    return ranges::fold_left(input.adj                                                    //
-                                 | views::keys                                            //
-                                 | views::filter([](auto& s) { return s.back() == 'A'; }) //
-                                 | views::transform([&](std::string s) {
-                                       return 1 + *(views::iota(0) | views::drop_while([&](int i) {
-                                                        return (s = input.instrs[i % input.instrs.size()] == 'L'
-                                                                        ? input.adj.find(s)->second.first
-                                                                        : input.adj.find(s)->second.second)
-                                                                   .back() != 'Z';
-                                                    })).begin();
+    const auto& graph = input.graph;
+    std::vector<uint8_t> isEnd(graph.size());
+    for (uint32_t node = 0; node < graph.size(); ++node) isEnd[node] = graph.name(node).back() == 'Z';
+    return ranges::fold_left(views::iota(uint32_t{0}, static_cast<uint32_t>(graph.size()))
+                                 | views::filter([&](uint32_t node) { return graph.name(node).back() == 'A'; })
+                                 | views::transform([&](uint32_t node) {
+                                       return countSteps(input, node, [&](uint32_t next) { return isEnd[next]; });
                                    }),
                              1LL, [](auto res, int e) { return std::lcm(res, e); });
 }
 
-std::pair<bool, bool> test() {
-    std::istringstream iss1{R"(
+std::vector<aoc::Sample> samples() {
+    constexpr std::string_view sample1{R"(
 RL
 
 AAA = (BBB, CCC)
@@ -65,31 +76,14 @@ EEE = (EEE, EEE)
 GGG = (GGG, GGG)
 ZZZ = (ZZZ, ZZZ)
 )"};
-    std::istringstream iss2{R"(
+    constexpr std::string_view sample2{R"(
 LLR
 
 AAA = (BBB, BBB)
 BBB = (AAA, ZZZ)
 ZZZ = (ZZZ, ZZZ)
 )"};
-    iss1.ignore();
-    const auto input1 = parseInput(iss1);
-    iss2.ignore();
-    const auto input2 = parseInput(iss2);
-
-    constexpr int part1CorrectAnswer1 = 2;
-    const int part1Answer1 = part1(input1);
-    const bool part1Correct1 = part1Answer1 == part1CorrectAnswer1;
-    fmt::print("Part 1: expected {}, got {}\n", part1CorrectAnswer1,
-               fmt::styled(part1Answer1, fmt::fg(part1Correct1 ? fmt::color::green : fmt::color::red)));
-    constexpr int part1CorrectAnswer2 = 6;
-    const int part1Answer2 = part1(input2);
-    const bool part1Correct2 = part1Answer2 == part1CorrectAnswer2;
-    fmt::print("Part 1: expected {}, got {}\n", part1CorrectAnswer2,
-               fmt::styled(part1Answer2, fmt::fg(part1Correct2 ? fmt::color::green : fmt::color::red)));
-    const bool part1Correct = part1Correct1 && part1Correct2;
-
-    std::istringstream iss3{R"(
+    constexpr std::string_view sample3{R"(
 LR
 
 11A = (11B, XXX)
@@ -101,40 +95,16 @@ LR
 22Z = (22B, 22B)
 XXX = (XXX, XXX)
 )"};
-    iss3.ignore();
-    const auto input3 = parseInput(iss3);
-    constexpr int64_t part2CorrectAnswer = 6;
-    const int64_t part2Answer = part2(input3);
-    const bool part2Correct = part2Answer == part2CorrectAnswer;
-    fmt::print("Part 2: expected {}, got {}\n", part2CorrectAnswer,
-               fmt::styled(part2Answer, fmt::fg(part2Correct ? fmt::color::green : fmt::color::red)));
-
-    return {part1Correct, part2Correct};
-}
-
-int main() {
-    auto [test1, test2] = test();
-    if (!test1) return 1;
-    auto in = std::ifstream(kInputFilename.data());
-    if (!in) {
-        fmt::print("Cannot open '{}'\n", kInputFilename);
-        return -1;
-    }
-    const auto input = parseInput(in);
-
-    auto getTimeColor = [](const auto& elapsed) {
-        return elapsed < 100ms ? fmt::color::light_green : elapsed < 1s ? fmt::color::orange : fmt::color::orange_red;
+    return {
+        aoc::makeSample(1, sample1, 2, parseInput, part1),
+        aoc::makeSample(1, sample2, 6, parseInput, part1),
+        aoc::makeSample(2, sample3, 6, parseInput, part2),
     };
-    auto startTime = cron::steady_clock::now();
-    const auto part1Ans = part1(input);
-    cron::duration<double> elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 1: {} in {}\n", fmt::styled(part1Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+}
 
-    if (!test2) return 2;
-    startTime = cron::steady_clock::now();
-    const auto part2Ans = part2(input);
-    elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 2: {} in {}\n", fmt::styled(part2Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+const aoc::Day& getDay() {
+    static const aoc::Day day = aoc::makeDay("day8", kInputFilename, samples(), parseInput, part1, part2);
+    return day;
 }
+
+} // namespace day8
@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day8
+{
+const aoc::Day& getDay();
+} // namespace day8
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day8::getDay(), argc, argv);
+}
@@ -1,115 +1,106 @@
+#include <aoc/day.hpp>
+#include <aoc/input.hpp>
+#include <aoc/scanner.hpp>
 #include <fmt/format.h>
-#include <fmt/color.h>
 #include <fmt/ranges.h>
 #include <vector>
-#include <sstream>
-#include <fstream>
 #include <numeric>
 #include <algorithm>
 #include <ranges>
-#include <stack>
-#include <chrono>
-namespace cron = std::chrono;
-using namespace std::chrono_literals;
 namespace ranges = std::ranges;
 namespace views = std::views;
 
+namespace day9
+{
+
 static constexpr std::string_view kInputFilename = "day9.txt";
 
 using Input = std::vector<std::vector<int>>;
 
-Input parseInput(std::istream& in) {
+constexpr std::vector<int> parseHistory(std::string_view line) {
+    aoc::Scanner iss{line};
+    std::vector<int> p;
+    for (int n; iss >> n;) p.push_back(n);
+    return p;
+}
+
+constexpr Input parseInput(std::string_view text) {
     Input res;
-    for (std::string line; std::getline(in, line);) {
-        std::istringstream iss{line};
-        std::vector<int> p;
-        for (int n; iss >> n;) p.push_back(n);
-        res.emplace_back(std::move(p));
-    }
+    for (std::string_view line : aoc::splitLines(text)) res.push_back(parseHistory(line));
     return res;
 }
 
-std::stack<std::vector<int>> getExtrapolateStack(const std::vector<int>& p) {
-    std::stack<std::vector<int>> res;
-    res.push(p);
+// Successive differences of `p`, the last non-zero one at the back. A vector rather than a std::stack, whose deque
+// cannot be used in a constant expression.
+constexpr std::vector<std::vector<int>> getExtrapolateStack(const std::vector<int>& p) {
+    std::vector<std::vector<int>> res;
+    res.push_back(p);
     for (size_t i = p.size(); i-- > 1;) {
-        const auto& q = res.top();
+        const auto& q = res.back();
         std::vector<int> qnext;
         std::adjacent_difference(begin(q) + 1, end(q), std::back_inserter(qnext));
         qnext[0] = q[1] - q[0];
         if (ranges::all_of(qnext, [](int n) { return n == 0; })) break;
-        res.push(std::move(qnext));
+        res.push_back(std::move(qnext));
     }
     return res;
 }
 
-int part1(const Input& input) {
-    return ranges::fold_left(input | views::transform([](const auto& p) {
-                                 auto st = getExtrapolateStack(p);
-                                 int next{};
-                                 for (; !st.empty(); st.pop()) next += st.top().back();
-                                 return next;
-                             }),
-                             0, std::plus{});
+constexpr int extrapolateNext(const std::vector<int>& p) {
+    auto st = getExtrapolateStack(p);
+    int next{};
+    for (; !st.empty(); st.pop_back()) next += st.back().back();
+    return next;
 }
 
-int part2(const Input& input) {
-    return ranges::fold_left(input | views::transform([](const auto& p) {
-                                 auto st = getExtrapolateStack(p);
-                                 int prev{};
-                                 for (; !st.empty(); st.pop()) prev = st.top().front() - prev;
-                                 return prev;
-                             }),
-                             0, std::plus{});
+constexpr int extrapolatePrevious(const std::vector<int>& p) {
+    auto st = getExtrapolateStack(p);
+    int prev{};
+    for (; !st.empty(); st.pop_back()) prev = st.back().front() - prev;
+    return prev;
 }
 
-std::pair<bool, bool> test() {
-    std::istringstream iss1{R"(
-0 3 6 9 12 15
-1 3 6 10 15 21
-10 13 16 21 30 45
-)"};
-    iss1.ignore();
-    const auto input1 = parseInput(iss1);
-
-    constexpr int part1CorrectAnswer = 114;
-    const int part1Answer = part1(input1);
-    const bool part1Correct = part1Answer == part1CorrectAnswer;
-    fmt::print("Part 1: expected {}, got {}\n", part1CorrectAnswer,
-               fmt::styled(part1Answer, fmt::fg(part1Correct ? fmt::color::green : fmt::color::red)));
-
-    constexpr int part2CorrectAnswer = 2;
-    const int part2Answer = part2(input1);
-    const bool part2Correct = part2Answer == part2CorrectAnswer;
-    fmt::print("Part 2: expected {}, got {}\n", part2CorrectAnswer,
-               fmt::styled(part2Answer, fmt::fg(part2Correct ? fmt::color::green : fmt::color::red)));
+constexpr int part1(const Input& input) {
+    return ranges::fold_left(input | views::transform(extrapolateNext), 0, std::plus{});
+}
 
-    return {part1Correct, part2Correct};
+constexpr int part2(const Input& input) {
+    return ranges::fold_left(input | views::transform(extrapolatePrevious), 0, std::plus{});
 }
 
-int main() {
-    auto [test1, test2] = test();
-    if (!test1) return 1;
-    auto in = std::ifstream(kInputFilename.data());
-    if (!in) {
-        fmt::print("Cannot open '{}'\n", kInputFilename);
-        return -1;
+// Both sums history by history, for --stream
+struct Fold {
+    int sum1{};
+    int sum2{};
+
+    void add(std::string_view line) {
+        const auto p = parseHistory(line);
+        if (p.empty()) return;
+        sum1 += extrapolateNext(p);
+        sum2 += extrapolatePrevious(p);
     }
-    const auto input = parseInput(in);
+    int part1() const { return sum1; }
+    int part2() const { return sum2; }
+};
 
-    auto getTimeColor = [](const auto& elapsed) {
-        return elapsed < 100ms ? fmt::color::light_green : elapsed < 1s ? fmt::color::orange : fmt::color::orange_red;
+std::vector<aoc::Sample> samples() {
+    constexpr std::string_view sample1{R"(
+0 3 6 9 12 15
+1 3 6 10 15 21
+10 13 16 21 30 45
+)"};
+    static_assert(part1(parseInput(aoc::sampleText(sample1))) == 114);
+    static_assert(part2(parseInput(aoc::sampleText(sample1))) == 2);
+    return {
+        aoc::checkedAtBuild(aoc::makeSample(1, sample1, 114, parseInput, part1)),
+        aoc::checkedAtBuild(aoc::makeSample(2, sample1, 2, parseInput, part2)),
     };
-    auto startTime = cron::steady_clock::now();
-    const auto part1Ans = part1(input);
-    cron::duration<double> elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 1: {} in {}\n", fmt::styled(part1Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+}
 
-    if (!test2) return 2;
-    startTime = cron::steady_clock::now();
-    const auto part2Ans = part2(input);
-    elapsed = cron::steady_clock::now() - startTime;
-    fmt::print("Part 2: {} in {}\n", fmt::styled(part2Ans, fmt::fg(fmt::color::yellow)),
-               fmt::styled(fmt::format("{:.06f}s", elapsed.count()), fmt::fg(getTimeColor(elapsed))));
+const aoc::Day& getDay() {
+    static const aoc::Day day =
+        aoc::withStream<Fold>(aoc::makeDay("day9", kInputFilename, samples(), parseInput, part1, part2));
+    return day;
 }
+
+} // namespace day9
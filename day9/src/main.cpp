@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace day9
+{
+const aoc::Day& getDay();
+} // namespace day9
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(day9::getDay(), argc, argv);
+}
@@ -0,0 +1,33 @@
+# Compares the parts of one day with their reference solutions on its samples, its real input and generated inputs of
+# the size of the real one, one per seed. Fails when an answer differs.
+#
+#   cmake -DAOC_GEN=<aoc-gen> -DAOC_DAY=dayN -DAOC_DAY_EXE=<dayN> -DAOC_DAY_DIR=<dir of dayN.txt>
+#         -DAOC_WORK_DIR=<dir> -DAOC_SEEDS=N -P check.cmake
+#
+# Generated inputs are kept in <dir>, so that a difference can be reproduced with `dayN --check <dir>/<seed>.txt`.
+cmake_minimum_required(VERSION 3.23)
+
+foreach(var AOC_GEN AOC_DAY AOC_DAY_EXE AOC_DAY_DIR AOC_WORK_DIR AOC_SEEDS)
+  if(NOT DEFINED ${var})
+    message(FATAL_ERROR "${var} is not set")
+  endif()
+endforeach()
+
+file(REMOVE_RECURSE "${AOC_WORK_DIR}")
+file(MAKE_DIRECTORY "${AOC_WORK_DIR}")
+foreach(seed RANGE 1 ${AOC_SEEDS})
+  execute_process(COMMAND "${AOC_GEN}" ${AOC_DAY} 1 --seed ${seed} -o "${AOC_WORK_DIR}/${seed}.txt" RESULT_VARIABLE rc)
+  if(NOT rc EQUAL 0)
+    message(FATAL_ERROR "aoc-gen ${AOC_DAY} 1 --seed ${seed} failed (${rc})")
+  endif()
+endforeach()
+
+execute_process(COMMAND "${AOC_DAY_EXE}" --check "${AOC_WORK_DIR}"
+                WORKING_DIRECTORY "${AOC_DAY_DIR}"
+                RESULT_VARIABLE rc
+                OUTPUT_VARIABLE output
+                ERROR_VARIABLE output)
+message("${output}")
+if(NOT rc EQUAL 0)
+  message(FATAL_ERROR "${AOC_DAY} differs from its reference (${rc})")
+endif()
@@ -0,0 +1,128 @@
+# Runs one day on generated inputs of growing size and prints the median time of every phase at each scale, with its
+# growth over the previous scale. A linear solver grows about as much as the input, anything well above that is
+# superlinear.
+#
+#   cmake -DAOC_GEN=<aoc-gen> -DAOC_DAY=dayN -DAOC_DAY_EXE=<dayN> -DAOC_WORK_DIR=<dir> -DAOC_SCALES=1,10,100
+#         [-DAOC_TIMEOUT=<seconds>] [-DAOC_MEMORY_LIMIT=<MB>] [-DAOC_STRICT=ON] -P scaling.cmake
+#
+# Inputs and JSON results are kept in <dir>/<scale>x/. A day that times out, goes over the memory limit or crashes is
+# reported in the table, or fails the script with AOC_STRICT.
+cmake_minimum_required(VERSION 3.23)
+
+foreach(var AOC_GEN AOC_DAY AOC_DAY_EXE AOC_WORK_DIR AOC_SCALES)
+  if(NOT DEFINED ${var})
+    message(FATAL_ERROR "${var} is not set")
+  endif()
+endforeach()
+set(timeout "")
+if(AOC_TIMEOUT)
+  set(timeout TIMEOUT ${AOC_TIMEOUT})
+endif()
+set(memory_limit "")
+if(AOC_MEMORY_LIMIT)
+  set(memory_limit --memory-limit ${AOC_MEMORY_LIMIT})
+endif()
+# Commas because a semicolon list does not survive add_custom_target arguments
+string(REPLACE "," ";" scales "${AOC_SCALES}")
+
+# "1.234567890" seconds to integer nanoseconds, math(EXPR) only knows 64-bit integers
+function(to_nanoseconds seconds out)
+  if(NOT seconds MATCHES "^([0-9]+)\\.?([0-9]*)$")
+    message(FATAL_ERROR "Unexpected time '${seconds}'")
+  endif()
+  string(SUBSTRING "${CMAKE_MATCH_2}000000000" 0 9 fraction)
+  math(EXPR res "${CMAKE_MATCH_1} * 1000000000 + 1${fraction} - 1000000000")
+  set(${out} ${res} PARENT_SCOPE)
+endfunction()
+
+function(format_seconds nanoseconds out)
+  math(EXPR whole "${nanoseconds} / 1000000000")
+  math(EXPR fraction "${nanoseconds} % 1000000000 + 1000000000")
+  string(SUBSTRING "${fraction}" 1 6 fraction)
+  set(${out} "${whole}.${fraction}s" PARENT_SCOPE)
+endfunction()
+
+function(pad text width out)
+  string(LENGTH "${text}" length)
+  if(length LESS width)
+    math(EXPR missing "${width} - ${length}")
+    string(REPEAT " " ${missing} spaces)
+    string(APPEND text "${spaces}")
+  endif()
+  set(${out} "${text}" PARENT_SCOPE)
+endfunction()
+
+set(phases "")
+foreach(scale IN LISTS scales)
+  set(dir "${AOC_WORK_DIR}/${scale}x")
+  file(MAKE_DIRECTORY "${dir}")
+  execute_process(COMMAND "${AOC_GEN}" ${AOC_DAY} ${scale} -o "${dir}/${AOC_DAY}.txt" RESULT_VARIABLE rc)
+  if(NOT rc EQUAL 0)
+    message(FATAL_ERROR "aoc-gen ${AOC_DAY} ${scale} failed (${rc})")
+  endif()
+
+  file(REMOVE "${dir}/${AOC_DAY}.json")
+  execute_process(COMMAND "${AOC_DAY_EXE}" --json "${AOC_DAY}.json" ${memory_limit}
+                  WORKING_DIRECTORY "${dir}"
+                  ${timeout}
+                  RESULT_VARIABLE rc
+                  OUTPUT_VARIABLE output
+                  ERROR_VARIABLE output)
+  # runDay returns 2 for a day without part 2, which is not a failure of the input, aoc::MemoryBudget exits with 3
+  set(status_${scale} "")
+  if(rc MATCHES "timeout")
+    set(status_${scale} "timeout")
+  elseif(rc EQUAL 3)
+    set(status_${scale} "out of memory")
+  elseif(NOT rc EQUAL 0 AND NOT rc EQUAL 2)
+    set(status_${scale} "failed")
+  endif()
+  if(AOC_STRICT AND status_${scale})
+    message(FATAL_ERROR "${AOC_DAY} at ${scale}x: ${status_${scale}} (${rc})\n${output}")
+  endif()
+
+  # Phases finished before a timeout are still in the file, every record is flushed as soon as it is measured
+  set(records "")
+  if(EXISTS "${dir}/${AOC_DAY}.json")
+    file(STRINGS "${dir}/${AOC_DAY}.json" records)
+  endif()
+  foreach(record IN LISTS records)
+    string(JSON phase GET "${record}" part)
+    # string(JSON) would hand the median back in exponent notation, the file has it in fixed notation
+    string(REGEX MATCH "\"median\": ([0-9.]+)" _ "${record}")
+    string(MAKE_C_IDENTIFIER "${phase}" key)
+    list(APPEND phases "${phase}")
+    to_nanoseconds(${CMAKE_MATCH_1} time_${key}_${scale})
+  endforeach()
+endforeach()
+list(REMOVE_DUPLICATES phases)
+
+foreach(phase IN LISTS phases)
+  string(MAKE_C_IDENTIFIER "${phase}" key)
+  pad("${AOC_DAY} ${phase}" 14 line)
+  unset(previous)
+  foreach(scale IN LISTS scales)
+    if(DEFINED time_${key}_${scale})
+      set(time ${time_${key}_${scale}})
+      format_seconds(${time} cell)
+      string(PREPEND cell "${scale}x ")
+      if(DEFINED previous AND previous GREATER 0)
+        math(EXPR growth "${time} * 10 / ${previous}")
+        math(EXPR whole "${growth} / 10")
+        math(EXPR tenths "${growth} % 10")
+        string(APPEND cell " (${whole}.${tenths}x)")
+      endif()
+      set(previous ${time})
+    else()
+      set(cell "${scale}x ${status_${scale}}")
+      unset(previous)
+    endif()
+    pad("${cell}" 28 cell)
+    string(APPEND line "${cell}")
+  endforeach()
+  string(STRIP "${line}" line)
+  message("${line}")
+endforeach()
+if(NOT phases)
+  message("${AOC_DAY} no phase finished")
+endif()
@@ -0,0 +1,739 @@
+#include "generators.hpp"
+#include <fmt/format.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace gen
+{
+
+namespace
+{
+
+// Only draws raw 64-bit values from mt19937_64, whose sequence the standard fixes, instead of going through the
+// std::*_distribution templates that differ between standard libraries
+class Rng {
+public:
+    explicit Rng(uint64_t seed) : engine{seed} {}
+
+    // Uniform in [lo, hi], the modulo bias is irrelevant for test data
+    int64_t between(int64_t lo, int64_t hi) {
+        return lo + static_cast<int64_t>(engine() % static_cast<uint64_t>(hi - lo + 1));
+    }
+    bool percent(int p) { return between(0, 99) < p; }
+    char pick(std::string_view chars) { return chars[static_cast<size_t>(between(0, std::ssize(chars) - 1))]; }
+
+    template <class T>
+    void shuffle(std::vector<T>& v) {
+        for (size_t i = v.size(); i > 1; --i) std::swap(v[i - 1], v[static_cast<size_t>(between(0, i - 1))]);
+    }
+
+private:
+    std::mt19937_64 engine;
+};
+
+constexpr std::string_view kLowercase = "abcdefghijklmnopqrstuvwxyz";
+
+// Side of a square grid with `scale` times the cells of a `base` x `base` one
+int scaledSide(int base, int scale) {
+    return static_cast<int>(std::lround(base * std::sqrt(static_cast<double>(scale))));
+}
+
+std::string joinLines(const std::vector<std::string>& lines) {
+    std::string res;
+    for (const auto& line : lines) {
+        res += line;
+        res += '\n';
+    }
+    return res;
+}
+
+// `count` distinct lowercase names of at least `minWidth` letters, none of them in `reserved`
+std::vector<std::string> uniqueNames(Rng& rng, size_t count, size_t minWidth, const std::set<std::string>& reserved) {
+    size_t width = minWidth;
+    double space = std::pow(26.0, static_cast<double>(width));
+    while (space < 2.0 * static_cast<double>(count + reserved.size())) {
+        ++width;
+        space *= 26.0;
+    }
+    std::set<std::string> seen = reserved;
+    std::vector<std::string> res;
+    while (res.size() < count) {
+        std::string name(width, ' ');
+        for (char& ch : name) ch = rng.pick(kLowercase);
+        if (seen.insert(name).second) res.push_back(std::move(name));
+    }
+    return res;
+}
+
+// Every cell of the closed axis-parallel path through `corners`, in order
+std::vector<std::pair<int, int>> tracePath(const std::vector<std::pair<int, int>>& corners) {
+    std::vector<std::pair<int, int>> res;
+    for (size_t i = 0; i < corners.size(); ++i) {
+        auto [r, c] = corners[i];
+        const auto [nr, nc] = corners[(i + 1) % corners.size()];
+        const int dr = (nr > r) - (nr < r);
+        const int dc = (nc > c) - (nc < c);
+        for (; r != nr || c != nc; r += dr, c += dc) res.emplace_back(r, c);
+    }
+    return res;
+}
+
+std::string day1(Rng& rng, int scale) {
+    constexpr std::array<std::string_view, 9> kDigitNames{"one", "two",   "three", "four", "five",
+                                                          "six", "seven", "eight", "nine"};
+    std::vector<std::string> lines(static_cast<size_t>(1000 * scale));
+    for (auto& line : lines) {
+        const auto tokens = rng.between(2, 8);
+        for (int64_t i = 0; i < tokens; ++i) {
+            const auto kind = rng.between(0, 2);
+            if (kind == 0) line += static_cast<char>('1' + rng.between(0, 8));
+            else if (kind == 1) line += kDigitNames[static_cast<size_t>(rng.between(0, 8))];
+            else line += rng.pick(kLowercase);
+        }
+        // Part 1 needs a digit on every line
+        line.insert(static_cast<size_t>(rng.between(0, std::ssize(line))), 1, static_cast<char>('1' + rng.between(0, 8)));
+    }
+    return joinLines(lines);
+}
+
+std::string day2(Rng& rng, int scale) {
+    std::string res;
+    for (int game = 1; game <= 100 * scale; ++game) {
+        fmt::format_to(std::back_inserter(res), "Game {}:", game);
+        const auto subsets = rng.between(1, 6);
+        for (int64_t i = 0; i < subsets; ++i) {
+            std::vector<std::string_view> colors{"red", "green", "blue"};
+            rng.shuffle(colors);
+            colors.resize(static_cast<size_t>(rng.between(1, 3)));
+            for (size_t j = 0; j < colors.size(); ++j)
+                fmt::format_to(std::back_inserter(res), "{} {} {}", j ? "," : "", rng.between(1, 20), colors[j]);
+            if (i + 1 < subsets) res += ';';
+        }
+        res += '\n';
+    }
+    return res;
+}
+
+std::string day3(Rng& rng, int scale) {
+    const int side = scaledSide(140, scale);
+    std::vector<std::string> rows(static_cast<size_t>(side), std::string(static_cast<size_t>(side), '.'));
+    for (auto& row : rows) {
+        for (auto c = rng.between(0, 3); c < side;) {
+            if (rng.percent(25)) {
+                row[static_cast<size_t>(c)] = rng.pick("*#+$/@=%&-");
+                c += rng.between(2, 5);
+                continue;
+            }
+            const auto digits = rng.between(1, 3);
+            if (c + digits > side) break;
+            for (int64_t i = 0; i < digits; ++i)
+                row[static_cast<size_t>(c + i)] = static_cast<char>(i ? '0' + rng.between(0, 9) : '1' + rng.between(0, 8));
+            c += digits + rng.between(1, 4);
+        }
+    }
+    return joinLines(rows);
+}
+
+std::string day4(Rng& rng, int scale) {
+    std::string res;
+    const int cards = 192 * scale;
+    for (int card = 1; card <= cards; ++card) {
+        std::vector<int> numbers(99);
+        std::iota(begin(numbers), end(numbers), 1);
+        rng.shuffle(numbers);
+        // Copies won by a card land at most on the end of its block of 8, which bounds the counts of part 2
+        const int matches = static_cast<int>(rng.between(0, std::min(7 - (card - 1) % 8, cards - card)));
+        const std::vector<int> winning(begin(numbers), begin(numbers) + 10);
+        std::vector<int> own(begin(numbers) + 10, begin(numbers) + 35 - matches);
+        own.insert(end(own), begin(winning), begin(winning) + matches);
+        rng.shuffle(own);
+        fmt::format_to(std::back_inserter(res), "Card {:3}:", card);
+        for (int n : winning) fmt::format_to(std::back_inserter(res), " {:2}", n);
+        res += " |";
+        for (int n : own) fmt::format_to(std::back_inserter(res), " {:2}", n);
+        res += '\n';
+    }
+    return res;
+}
+
+std::string day5(Rng& rng, int scale) {
+    constexpr int64_t kUniverse = int64_t{1} << 32;
+    constexpr std::array<std::string_view, 8> kCategories{"seed",  "soil",        "fertilizer", "water",
+                                                          "light", "temperature", "humidity",   "location"};
+    std::string res = "seeds:";
+    for (int i = 0; i < 10 * scale; ++i) {
+        const auto start = rng.between(0, kUniverse - 2);
+        fmt::format_to(std::back_inserter(res), " {} {}", start,
+                       rng.between(1, std::min<int64_t>(400'000'000, kUniverse - start)));
+    }
+    res += '\n';
+    for (size_t map = 0; map + 1 < kCategories.size(); ++map) {
+        // A permutation of [0, 2^32) made of shuffled segments, with some lines left out so they map to themselves
+        std::set<int64_t> cuts{0, kUniverse};
+        while (std::ssize(cuts) < 30 * scale + 1) cuts.insert(rng.between(1, kUniverse - 1));
+        std::vector<std::pair<int64_t, int64_t>> segments;
+        for (auto it = begin(cuts); std::next(it) != end(cuts); ++it) segments.emplace_back(*it, *std::next(it) - *it);
+        rng.shuffle(segments);
+        std::vector<std::string> lines;
+        int64_t destination{};
+        for (const auto& [source, length] : segments) {
+            if (rng.percent(90)) lines.push_back(fmt::format("{} {} {}", destination, source, length));
+            destination += length;
+        }
+        rng.shuffle(lines);
+        fmt::format_to(std::back_inserter(res), "\n{}-to-{} map:\n{}", kCategories[map], kCategories[map + 1],
+                       joinLines(lines));
+    }
+    return res;
+}
+
+// Part 2 concatenates the race times into one number, so a bigger input cannot have more races
+std::string day6(Rng& rng, int /*scale*/) {
+    std::string times = "Time:     ";
+    std::string distances = "Distance: ";
+    for (int i = 0; i < 4; ++i) {
+        const auto time = rng.between(40, 99);
+        const auto hold = rng.between(time / 4, time / 2);
+        fmt::format_to(std::back_inserter(times), " {:6}", time);
+        fmt::format_to(std::back_inserter(distances), " {:6}", hold * (time - hold) - rng.between(1, 20));
+    }
+    return times + '\n' + distances + '\n';
+}
+
+std::string day7(Rng& rng, int scale) {
+    std::string res;
+    for (int i = 0; i < 1000 * scale; ++i) {
+        std::string hand(5, ' ');
+        for (char& card : hand) card = rng.pick("AKQJT98765432");
+        fmt::format_to(std::back_inserter(res), "{} {}\n", hand, rng.between(1, 1000));
+    }
+    return res;
+}
+
+// Six ghosts, each starting on a ring whose length is a different prime multiple of the instruction count. Every ring
+// node comes in a left and a right copy so both instructions move along the ring, and the ring ends on its only node
+// that ends in Z. The node names are three letters, which caps the size at about 20x.
+std::string day8(Rng& rng, int scale) {
+    constexpr std::array<int, 6> kRingFactors{3, 5, 7, 11, 13, 17};
+    constexpr int kFactorSum = 3 + 5 + 7 + 11 + 13 + 17;
+    auto isPrime = [](int n) {
+        for (int d = 2; d * d <= n; ++d)
+            if (n % d == 0) return false;
+        return n > 1;
+    };
+    int length = std::min(7 * scale, 26 * 26 * 24 / (2 * kFactorSum));
+    while (!isPrime(length)) --length;
+
+    std::vector<std::string> middle;
+    for (char a = 'A'; a <= 'Z'; ++a)
+        for (char b = 'A'; b <= 'Z'; ++b)
+            for (char c = 'B'; c <= 'Y'; ++c) middle.push_back({a, b, c});
+    rng.shuffle(middle);
+    std::vector<std::string> starts{"AAA"};
+    std::vector<std::string> ends{"ZZZ"};
+    while (starts.size() < kRingFactors.size()) {
+        std::string name{rng.pick(kLowercase), rng.pick(kLowercase), 'a'};
+        for (char& ch : name) ch = static_cast<char>(ch - 'a' + 'A');
+        if (std::ranges::find(starts, name) == end(starts)) starts.push_back(name);
+    }
+    while (ends.size() < kRingFactors.size()) {
+        std::string name{rng.pick(kLowercase), rng.pick(kLowercase), 'z'};
+        for (char& ch : name) ch = static_cast<char>(ch - 'a' + 'A');
+        if (std::ranges::find(ends, name) == end(ends)) ends.push_back(name);
+    }
+
+    std::string instructions(static_cast<size_t>(length), ' ');
+    for (char& ch : instructions) ch = rng.pick("LR");
+    std::vector<std::string> lines;
+    auto nextName = begin(middle);
+    for (size_t ghost = 0; ghost < kRingFactors.size(); ++ghost) {
+        const auto ringLength = static_cast<size_t>(length * kRingFactors[ghost]);
+        std::vector<std::pair<std::string, std::string>> ring;
+        for (size_t i = 1; i < ringLength; ++i) {
+            ring.emplace_back(*nextName, *std::next(nextName));
+            nextName += 2;
+        }
+        const auto& first = ring.front();
+        lines.push_back(fmt::format("{} = ({}, {})", starts[ghost], first.first, first.second));
+        lines.push_back(fmt::format("{} = ({}, {})", ends[ghost], first.first, first.second));
+        for (size_t i = 0; i < ring.size(); ++i) {
+            const std::string left = i + 1 < ring.size() ? ring[i + 1].first : ends[ghost];
+            const std::string right = i + 1 < ring.size() ? ring[i + 1].second : ends[ghost];
+            lines.push_back(fmt::format("{} = ({}, {})", ring[i].first, left, right));
+            lines.push_back(fmt::format("{} = ({}, {})", ring[i].second, left, right));
+        }
+    }
+    rng.shuffle(lines);
+    return instructions + "\n\n" + joinLines(lines);
+}
+
+// Values of a polynomial sequence, built by summing up a random difference table
+std::string day9(Rng& rng, int scale) {
+    std::string res;
+    for (int line = 0; line < 200 * scale;) {
+        std::vector<int64_t> differences(static_cast<size_t>(rng.between(2, 7)));
+        for (auto& d : differences) d = rng.between(-10, 10);
+        std::vector<int64_t> values;
+        for (int i = 0; i < 21; ++i) {
+            values.push_back(differences[0]);
+            for (size_t j = 0; j + 1 < differences.size(); ++j) differences[j] += differences[j + 1];
+        }
+        if (std::ranges::any_of(values, [](int64_t v) { return std::abs(v) >= 50'000; })) continue;
+        for (size_t i = 0; i < values.size(); ++i) fmt::format_to(std::back_inserter(res), "{}{}", i ? " " : "", values[i]);
+        res += '\n';
+        ++line;
+    }
+    return res;
+}
+
+// A comb-shaped loop through random junk pipes
+std::string day10(Rng& rng, int scale) {
+    const int side = scaledSide(140, scale);
+    const int top = 1;
+    const int left = 1;
+    const int bottom = side - 2;
+    std::vector<std::pair<int, int>> corners{{top, left}, {top, side - 2}};
+    for (int x = side - 2;;) {
+        const int room = x - left + 1;
+        const bool last = room < 7;
+        const int width = last ? room : static_cast<int>(rng.between(3, std::min(8, room - 4)));
+        const int depth = static_cast<int>(rng.between(top + 3, bottom));
+        corners.emplace_back(depth, x);
+        corners.emplace_back(depth, x - width + 1);
+        if (last) break; // the closing edge runs up the left column back to the start
+        corners.emplace_back(top + 2, x - width + 1);
+        x = x - width + 1 - static_cast<int>(rng.between(1, std::min(3, room - width - 3)));
+        corners.emplace_back(top + 2, x);
+    }
+    const auto loop = tracePath(corners);
+
+    std::vector<std::string> rows(static_cast<size_t>(side), std::string(static_cast<size_t>(side), '.'));
+    for (auto& row : rows)
+        for (char& ch : row) ch = rng.pick("|-LJ7F...");
+    auto direction = [](std::pair<int, int> from, std::pair<int, int> to) {
+        return to.first < from.first ? 0 : to.second > from.second ? 1 : to.first > from.first ? 2 : 3;
+    };
+    // Indexed by the bit set of the two directions to the neighbors, up = 1, right = 2, down = 4, left = 8
+    constexpr std::string_view kPipes = "...L.|F..J-.7...";
+    std::vector<std::string> onLoop(static_cast<size_t>(side), std::string(static_cast<size_t>(side), '\0'));
+    for (size_t i = 0; i < loop.size(); ++i) {
+        const auto& prev = loop[(i + loop.size() - 1) % loop.size()];
+        const auto& next = loop[(i + 1) % loop.size()];
+        const int mask = (1 << direction(loop[i], prev)) | (1 << direction(loop[i], next));
+        rows[loop[i].first][loop[i].second] = kPipes[static_cast<size_t>(mask)];
+        onLoop[loop[i].first][loop[i].second] = 1;
+    }
+    // Only the two loop neighbors of S may connect to it
+    const auto [sr, sc] = loop[static_cast<size_t>(rng.between(0, std::ssize(loop) - 1))];
+    rows[sr][sc] = 'S';
+    for (const auto& [dr, dc] : {std::pair{-1, 0}, {0, 1}, {1, 0}, {0, -1}})
+        if (!onLoop[sr + dr][sc + dc]) rows[sr + dr][sc + dc] = '.';
+    return joinLines(rows);
+}
+
+std::string day11(Rng& rng, int scale) {
+    const int side = scaledSide(140, scale);
+    std::vector<bool> emptyRow(static_cast<size_t>(side));
+    std::vector<bool> emptyCol(static_cast<size_t>(side));
+    for (int i = 0; i < side; ++i) {
+        emptyRow[i] = rng.percent(7);
+        emptyCol[i] = rng.percent(7);
+    }
+    std::vector<std::string> rows(static_cast<size_t>(side), std::string(static_cast<size_t>(side), '.'));
+    for (int r = 0; r < side; ++r)
+        for (int c = 0; c < side; ++c)
+            if (!emptyRow[r] && !emptyCol[c] && rng.between(0, 39) == 0) rows[r][c] = '#';
+    return joinLines(rows);
+}
+
+// Valid rows of springs with about half of the cells hidden
+std::string day12(Rng& rng, int scale) {
+    std::string res;
+    for (int line = 0; line < 1000 * scale;) {
+        std::string row(static_cast<size_t>(rng.between(0, 3)), '.');
+        std::string groups;
+        const auto groupCount = rng.between(1, 6);
+        for (int64_t i = 0; i < groupCount; ++i) {
+            const auto size = rng.between(1, 5);
+            if (i) row.append(static_cast<size_t>(rng.between(1, 3)), '.');
+            row.append(static_cast<size_t>(size), '#');
+            groups += fmt::format("{}{}", i ? "," : "", size);
+        }
+        row.append(static_cast<size_t>(rng.between(0, 3)), '.');
+        if (row.size() > 20) continue;
+        for (char& ch : row)
+            if (rng.percent(50)) ch = '?';
+        fmt::format_to(std::back_inserter(res), "{} {}\n", row, groups);
+        ++line;
+    }
+    return res;
+}
+
+// Patterns mirrored about a column and then about a row, with one flipped cell outside the row mirror so that part 2
+// finds a different line than part 1
+std::string day13(Rng& rng, int scale) {
+    std::string res;
+    for (int pattern = 0; pattern < 100 * scale; ++pattern) {
+        const int h = static_cast<int>(rng.between(7, 17));
+        const int w = static_cast<int>(rng.between(7, 17));
+        std::vector<std::string> rows(static_cast<size_t>(h), std::string(static_cast<size_t>(w), '.'));
+        for (auto& row : rows)
+            for (char& ch : row) ch = rng.pick("#.");
+        const int j = static_cast<int>(rng.between(1, w - 1));
+        for (auto& row : rows)
+            for (int c = j; c < std::min(w, 2 * j); ++c) row[c] = row[2 * j - 1 - c];
+        const int i = static_cast<int>(rng.between(1, (h - 1) / 2));
+        for (int r = i; r < 2 * i; ++r) rows[r] = rows[2 * i - 1 - r];
+        char& flipped = rows[rng.between(2 * i, h - 1)][rng.between(std::max(0, 2 * j - w), j - 1)];
+        flipped = flipped == '#' ? '.' : '#';
+        if (rng.percent(50)) {
+            std::vector<std::string> transposed(static_cast<size_t>(w), std::string(static_cast<size_t>(h), '.'));
+            for (int r = 0; r < h; ++r)
+                for (int c = 0; c < w; ++c) transposed[c][r] = rows[r][c];
+            rows = std::move(transposed);
+        }
+        fmt::format_to(std::back_inserter(res), "{}{}", pattern ? "\n" : "", joinLines(rows));
+    }
+    return res;
+}
+
+std::string day14(Rng& rng, int scale) {
+    const int side = scaledSide(100, scale);
+    std::vector<std::string> rows(static_cast<size_t>(side), std::string(static_cast<size_t>(side), '.'));
+    for (auto& row : rows) {
+        for (char& ch : row) {
+            const auto roll = rng.between(0, 99);
+            ch = roll < 20 ? 'O' : roll < 37 ? '#' : '.';
+        }
+    }
+    return joinLines(rows);
+}
+
+std::string day15(Rng& rng, int scale) {
+    const auto labels = uniqueNames(rng, static_cast<size_t>(300 * scale), 3, {});
+    std::string res;
+    for (int i = 0; i < 4000 * scale; ++i) {
+        const auto& label = labels[static_cast<size_t>(rng.between(0, std::ssize(labels) - 1))];
+        if (rng.percent(40)) fmt::format_to(std::back_inserter(res), "{}{}-", i ? "," : "", label);
+        else fmt::format_to(std::back_inserter(res), "{}{}={}", i ? "," : "", label, rng.between(1, 9));
+    }
+    return res + '\n';
+}
+
+std::string day16(Rng& rng, int scale) {
+    const int side = scaledSide(110, scale);
+    std::vector<std::string> rows(static_cast<size_t>(side), std::string(static_cast<size_t>(side), '.'));
+    for (auto& row : rows)
+        for (char& ch : row)
+            if (rng.percent(10)) ch = rng.pick("/\\|-");
+    return joinLines(rows);
+}
+
+std::string day17(Rng& rng, int scale) {
+    const int side = scaledSide(141, scale);
+    std::vector<std::string> rows(static_cast<size_t>(side), std::string(static_cast<size_t>(side), '.'));
+    for (auto& row : rows)
+        for (char& ch : row) ch = static_cast<char>('1' + rng.between(0, 8));
+    return joinLines(rows);
+}
+
+struct DigMove {
+    char dir{};
+    int64_t length{};
+};
+
+// Comb-shaped dig plan: right along the top, then teeth hanging down on the way back to the start. The top strip is
+// `height` deep, so (1, 1) is inside when height >= 2.
+std::vector<DigMove> digComb(Rng& rng, int teeth, int64_t height, int64_t minSpan, int64_t maxSpan, int64_t maxDepth,
+                             int pieces) {
+    std::vector<DigMove> moves;
+    int64_t width{};
+    for (int i = 0; i < teeth; ++i) {
+        const auto depth = rng.between(height + minSpan, maxDepth);
+        const auto toothWidth = rng.between(minSpan, maxSpan);
+        if (i == 0) moves.push_back({'D', depth});
+        else moves.push_back({'D', depth - height});
+        moves.push_back({'L', toothWidth});
+        moves.push_back({'U', i + 1 < teeth ? depth - height : depth});
+        width += toothWidth;
+        if (i + 1 < teeth) {
+            const auto gap = rng.between(minSpan, maxSpan);
+            moves.push_back({'L', gap});
+            width += gap;
+        }
+    }
+    // The top edge in equal pieces, the last one taking the remainder
+    std::vector<DigMove> res;
+    for (int i = 0; i < pieces; ++i) res.push_back({'R', width / pieces + (i + 1 == pieces ? width % pieces : 0)});
+    res.insert(end(res), begin(moves), end(moves));
+    return res;
+}
+
+// Two dig plans with the same shape of moves, a small one in the plain instructions for part 1 and a big one in the
+// colors for part 2
+std::string day18(Rng& rng, int scale) {
+    constexpr int64_t kMaxHex = 0xFFFFF;
+    const int teeth = 177 * scale;
+    // Both plans need the same number of moves, so split the top edge of the big one enough to fit in five hex digits
+    const int pieces = static_cast<int>(teeth * int64_t{60'000} / kMaxHex + 1);
+    const auto small = digComb(rng, teeth, 2, 2, 6, 14, pieces);
+    const auto big = digComb(rng, teeth, 20'000, 2'000, 30'000, 900'000, pieces);
+    std::string res;
+    for (size_t i = 0; i < small.size(); ++i) {
+        const auto hexDir = std::string_view{"RDLU"}.find(big[i].dir);
+        fmt::format_to(std::back_inserter(res), "{} {} (#{:05x}{})\n", small[i].dir, small[i].length, big[i].length,
+                       hexDir);
+    }
+    return res;
+}
+
+// A tree of workflows below "in" so every part ends in A or R, followed by the parts
+std::string day19(Rng& rng, int scale) {
+    const auto count = static_cast<size_t>(550 * scale);
+    auto names = uniqueNames(rng, count, 2, {"in"});
+    names[0] = "in";
+    std::vector<std::string> lines;
+    size_t created = 1;
+    for (size_t workflow = 0; workflow < count; ++workflow) {
+        const auto targetCount = rng.between(2, 4);
+        std::vector<std::string> targets;
+        for (int64_t i = 0; i < targetCount; ++i) {
+            // Every workflow has to be created by an earlier one, so force a child when nothing else is pending. "in"
+            // only sends parts on, or most of them would be decided right away.
+            const bool mustCreate = workflow == 0 || (created == workflow + 1 && i + 1 == targetCount);
+            if (created < count && (mustCreate || rng.percent(50))) targets.push_back(names[created++]);
+            else targets.push_back(rng.percent(50) ? "A" : "R");
+        }
+        std::string line = names[workflow] + '{';
+        for (size_t i = 0; i + 1 < targets.size(); ++i)
+            line += fmt::format("{}{}{}:{},", rng.pick("xmas"), rng.pick("<>"), rng.between(1, 4000), targets[i]);
+        lines.push_back(line + targets.back() + '}');
+    }
+    rng.shuffle(lines);
+    std::string res = joinLines(lines) + '\n';
+    for (int part = 0; part < 200 * scale; ++part) {
+        fmt::format_to(std::back_inserter(res), "{{x={},m={},a={},s={}}}\n", rng.between(1, 4000),
+                       rng.between(1, 4000), rng.between(1, 4000), rng.between(1, 4000));
+    }
+    return res;
+}
+
+// Four 12-bit counters made of flip-flop chains, each feeding a hub conjunction that fires at a different prime. The
+// answer of part 2 is the product of the primes, so the module count stays the same at every scale.
+std::string day20(Rng& rng, int /*scale*/) {
+    constexpr int kChains = 4;
+    constexpr int kBits = 12;
+    std::vector<int> primes;
+    for (int n = 3700; n < 4096; ++n) {
+        bool prime = true;
+        for (int d = 2; d * d <= n; ++d) prime &= n % d != 0;
+        if (prime) primes.push_back(n);
+    }
+    rng.shuffle(primes);
+    const auto names = uniqueNames(rng, kChains * (kBits + 2) + 1, 2, {"rx"});
+    const auto& output = names.back();
+    std::vector<std::string> lines;
+    std::string broadcast = "broadcaster ->";
+    for (int chain = 0; chain < kChains; ++chain) {
+        const int period = primes[chain];
+        const auto* flipFlops = &names[static_cast<size_t>(chain * (kBits + 2))];
+        const auto& hub = flipFlops[kBits];
+        const auto& inverter = flipFlops[kBits + 1];
+        fmt::format_to(std::back_inserter(broadcast), "{} {}", chain ? "," : "", flipFlops[0]);
+        std::string hubLine = fmt::format("&{} -> {}", hub, inverter);
+        for (int bit = 0; bit < kBits; ++bit) {
+            std::vector<std::string> targets;
+            if (bit + 1 < kBits) targets.push_back(flipFlops[bit + 1]);
+            if (period >> bit & 1) targets.push_back(hub);
+            if (!(period >> bit & 1) || bit == 0) hubLine += ", " + flipFlops[bit];
+            rng.shuffle(targets);
+            lines.push_back(fmt::format("%{} -> {}", flipFlops[bit], fmt::join(targets, ", ")));
+        }
+        lines.push_back(hubLine);
+        lines.push_back(fmt::format("&{} -> {}", inverter, output));
+    }
+    lines.push_back(broadcast);
+    lines.push_back(fmt::format("&{} -> rx", output));
+    rng.shuffle(lines);
+    return joinLines(lines);
+}
+
+// Square garden with S in the middle of clear middle lines, a clear border and a clear diamond, like the real input
+std::string day21(Rng& rng, int scale) {
+    const int side = scaledSide(131, scale) | 1;
+    const int mid = side / 2;
+    std::vector<std::string> rows(static_cast<size_t>(side), std::string(static_cast<size_t>(side), '.'));
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            const bool clear = r == 0 || c == 0 || r == side - 1 || c == side - 1 || r == mid || c == mid ||
+                               std::abs(std::abs(r - mid) + std::abs(c - mid) - mid) <= 1;
+            if (!clear && rng.percent(12)) rows[r][c] = '#';
+        }
+    }
+    rows[mid][mid] = 'S';
+    return joinLines(rows);
+}
+
+// Bricks stacked with small gaps on a 10x10 footprint, listed in random order
+std::string day22(Rng& rng, int scale) {
+    std::array<std::array<int64_t, 10>, 10> height{};
+    std::vector<std::string> lines;
+    for (int brick = 0; brick < 1203 * scale; ++brick) {
+        const auto length = rng.between(1, 4);
+        const auto axis = rng.between(0, 2);
+        const auto x1 = rng.between(0, axis == 0 ? 10 - length : 9);
+        const auto y1 = rng.between(0, axis == 1 ? 10 - length : 9);
+        const auto x2 = x1 + (axis == 0 ? length - 1 : 0);
+        const auto y2 = y1 + (axis == 1 ? length - 1 : 0);
+        int64_t base{};
+        for (auto x = x1; x <= x2; ++x)
+            for (auto y = y1; y <= y2; ++y) base = std::max(base, height[x][y]);
+        const auto z1 = base + 1 + rng.between(0, 3);
+        const auto z2 = z1 + (axis == 2 ? length - 1 : 0);
+        for (auto x = x1; x <= x2; ++x)
+            for (auto y = y1; y <= y2; ++y) height[x][y] = z2;
+        lines.push_back(fmt::format("{},{},{}~{},{},{}", x1, y1, z1, x2, y2, z2));
+    }
+    rng.shuffle(lines);
+    return joinLines(lines);
+}
+
+// A 6x6 lattice of junctions joined by straight corridors with slopes pointing right and down at both ends, like the
+// real input. Part 2 is exponential in the junction count, so scaling only lengthens the corridors.
+std::string day23(Rng& rng, int scale) {
+    constexpr int kJunctions = 6;
+    const int spacing = std::max(4, scaledSide(27, scale));
+    const int side = spacing * (kJunctions - 1) + 3;
+    std::vector<std::string> rows(static_cast<size_t>(side), std::string(static_cast<size_t>(side), '#'));
+    auto at = [](int i, int spacing) { return 1 + i * spacing; };
+    for (int a = 0; a < kJunctions; ++a) {
+        for (int b = 0; b + 1 < kJunctions; ++b) {
+            for (int i = at(b, spacing); i <= at(b + 1, spacing); ++i) {
+                rows[at(a, spacing)][i] = '.';
+                rows[i][at(a, spacing)] = '.';
+            }
+            rows[at(a, spacing)][at(b, spacing) + 1] = '>';
+            rows[at(a, spacing)][at(b + 1, spacing) - 1] = '>';
+            rows[at(b, spacing) + 1][at(a, spacing)] = 'v';
+            rows[at(b + 1, spacing) - 1][at(a, spacing)] = 'v';
+        }
+    }
+    rows[0][1] = '.';
+    rows[side - 1][side - 2] = '.';
+    // Dead-end alcoves off the corridors so the walls are not all solid
+    for (int i = 0; i < side * side / 200; ++i) {
+        const auto r = rng.between(2, side - 3);
+        const auto c = rng.between(2, side - 3);
+        const int openNeighbors = (rows[r - 1][c] == '.') + (rows[r + 1][c] == '.') + (rows[r][c - 1] == '.') +
+                                  (rows[r][c + 1] == '.');
+        if (rows[r][c] == '#' && openNeighbors == 1) rows[r][c] = '.';
+    }
+    return joinLines(rows);
+}
+
+// Hailstones that a rock thrown from P with velocity V hits at distinct integer times, like the real input. Part 2
+// needs stones sharing a velocity component, which the narrow velocity range provides.
+std::string day24(Rng& rng, int scale) {
+    std::array<int64_t, 3> rockPosition{};
+    std::array<int64_t, 3> rockVelocity{};
+    for (auto& p : rockPosition) p = rng.between(200'000'000'000'000, 350'000'000'000'000);
+    for (auto& v : rockVelocity) v = rng.between(-250, 250);
+    std::set<int64_t> times;
+    std::string res;
+    for (int stone = 0; stone < 300 * scale; ++stone) {
+        std::array<int64_t, 3> position{};
+        std::array<int64_t, 3> velocity{};
+        for (;;) {
+            const auto time = rng.between(10'000'000'000, 300'000'000'000);
+            if (times.contains(time)) continue;
+            for (size_t axis = 0; axis < 3; ++axis) {
+                do {
+                    velocity[axis] = rng.between(-400, 400);
+                } while (velocity[axis] == rockVelocity[axis]);
+                position[axis] = rockPosition[axis] + (rockVelocity[axis] - velocity[axis]) * time;
+            }
+            if (std::ranges::all_of(position, [](int64_t p) { return p > 0; })) {
+                times.insert(time);
+                break;
+            }
+        }
+        fmt::format_to(std::back_inserter(res), "{}, {}, {} @ {}, {}, {}\n", position[0], position[1], position[2],
+                       velocity[0], velocity[1], velocity[2]);
+    }
+    return res;
+}
+
+// Two well connected halves joined by exactly three wires
+std::string day25(Rng& rng, int scale) {
+    const int count = 1515 * scale;
+    const int firstHalf = count / 2 + static_cast<int>(rng.between(-count / 10, count / 10));
+    std::set<std::pair<int, int>> edges;
+    for (const auto& [offset, size] : {std::pair{0, firstHalf}, {firstHalf, count - firstHalf}}) {
+        // Two random rings without a common wire, so a cut inside a half needs at least four wires
+        std::vector<int> order(static_cast<size_t>(size));
+        std::iota(begin(order), end(order), offset);
+        for (int ring = 0; ring < 2;) {
+            rng.shuffle(order);
+            std::vector<std::pair<int, int>> ringEdges;
+            for (size_t i = 0; i < order.size(); ++i) {
+                const int u = order[i];
+                const int v = order[(i + 1) % order.size()];
+                ringEdges.emplace_back(std::min(u, v), std::max(u, v));
+            }
+            if (std::ranges::any_of(ringEdges, [&](const auto& e) { return edges.contains(e); })) continue;
+            edges.insert(begin(ringEdges), end(ringEdges));
+            ++ring;
+        }
+    }
+    std::set<int> bridgeEnds;
+    for (int bridge = 0; bridge < 3;) {
+        const auto u = static_cast<int>(rng.between(0, firstHalf - 1));
+        const auto v = static_cast<int>(rng.between(firstHalf, count - 1));
+        if (bridgeEnds.contains(u) || bridgeEnds.contains(v)) continue;
+        bridgeEnds.insert({u, v});
+        edges.emplace(u, v);
+        ++bridge;
+    }
+    const auto names = uniqueNames(rng, static_cast<size_t>(count), 3, {});
+    // Each wire is listed once, on the line of either of its ends
+    std::vector<std::vector<int>> listed(static_cast<size_t>(count));
+    for (const auto& [u, v] : edges) {
+        if (rng.percent(50)) listed[u].push_back(v);
+        else listed[v].push_back(u);
+    }
+    std::vector<std::string> lines;
+    for (int u = 0; u < count; ++u) {
+        if (listed[u].empty()) continue;
+        std::string line = names[u] + ':';
+        for (int v : listed[u]) line += ' ' + names[v];
+        lines.push_back(std::move(line));
+    }
+    rng.shuffle(lines);
+    return joinLines(lines);
+}
+
+} // namespace
+
+std::string generate(std::string_view day, int scale, uint64_t seed) {
+    using Generator = std::string (*)(Rng&, int);
+    constexpr std::array<Generator, 25> kGenerators{day1,  day2,  day3,  day4,  day5,  day6,  day7,  day8,  day9,
+                                                    day10, day11, day12, day13, day14, day15, day16, day17, day18,
+                                                    day19, day20, day21, day22, day23, day24, day25};
+    for (size_t i = 0; i < kGenerators.size(); ++i) {
+        if (day != fmt::format("day{}", i + 1)) continue;
+        // Every day draws its own sequence from the seed
+        Rng rng{seed * kGenerators.size() + i};
+        return kGenerators[i](rng, scale);
+    }
+    return {};
+}
+
+} // namespace gen
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace gen
+{
+
+// Puzzle input for `day` ("day1" ... "day25") with the structure of the real one and about `scale` times its size.
+// Empty for an unknown day. The same seed gives the same input on every platform.
+std::string generate(std::string_view day, int scale, uint64_t seed);
+
+} // namespace gen
@@ -0,0 +1,79 @@
+#include "generators.hpp"
+#include <fmt/format.h>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <optional>
+#include <string>
+
+namespace
+{
+
+void printUsage(std::string_view program) {
+    fmt::print("Usage: {} dayN SCALE [--seed N] [-o FILE]\n", program);
+    fmt::print("  dayN       day to generate an input for, day1 ... day25\n");
+    fmt::print("  SCALE      size relative to the real puzzle input, e.g. 1, 10 or 100\n");
+    fmt::print("  --seed N   random seed (default: 1)\n");
+    fmt::print("  -o FILE    write to FILE instead of stdout\n");
+}
+
+template <class T>
+std::optional<T> parseNumber(std::string_view sv, T min) {
+    T res{};
+    const auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), res);
+    if (ec != std::errc{} || ptr != sv.data() + sv.size() || res < min) return std::nullopt;
+    return res;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::string_view program = argc > 0 ? argv[0] : "aoc-gen";
+    if (argc < 3) {
+        printUsage(program);
+        return -1;
+    }
+    const std::string_view day = argv[1];
+    const auto scale = parseNumber<int>(argv[2], 1);
+    if (!scale) {
+        fmt::print("Invalid scale '{}'\n", argv[2]);
+        printUsage(program);
+        return -1;
+    }
+    uint64_t seed = 1;
+    std::string outputFilename;
+    for (int i = 3; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--seed" && hasValue) {
+            if (const auto value = parseNumber<uint64_t>(argv[i + 1], 0)) {
+                seed = *value;
+                ++i;
+                continue;
+            }
+        } else if (arg == "-o" && hasValue) {
+            outputFilename = argv[++i];
+            continue;
+        }
+        fmt::print("Invalid argument '{}'\n", arg);
+        printUsage(program);
+        return -1;
+    }
+
+    const std::string input = gen::generate(day, *scale, seed);
+    if (input.empty()) {
+        fmt::print("Unknown day '{}'\n", day);
+        printUsage(program);
+        return -1;
+    }
+    if (outputFilename.empty()) {
+        std::fwrite(input.data(), 1, input.size(), stdout);
+        return 0;
+    }
+    std::ofstream file{outputFilename, std::ios::binary};
+    if (!file.write(input.data(), static_cast<std::streamsize>(input.size()))) {
+        fmt::print("Cannot write '{}'\n", outputFilename);
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,18 @@
+# Runs one day on its real input and appends its benchmark records to the history file.
+#
+#   cmake -DAOC_DAY_EXE=<dayN> -DAOC_DAY_DIR=<dir of dayN.txt> -DAOC_HISTORY_FILE=<file> -DAOC_REPS=<N> -P record.cmake
+cmake_minimum_required(VERSION 3.23)
+
+foreach(var AOC_DAY_EXE AOC_DAY_DIR AOC_HISTORY_FILE AOC_REPS)
+  if(NOT DEFINED ${var})
+    message(FATAL_ERROR "${var} is not set")
+  endif()
+endforeach()
+
+execute_process(COMMAND "${AOC_DAY_EXE}" --warmup 1 --reps ${AOC_REPS} --history "${AOC_HISTORY_FILE}"
+                WORKING_DIRECTORY "${AOC_DAY_DIR}"
+                RESULT_VARIABLE rc)
+# runDay returns 2 for a day without part 2, its part 1 is still recorded
+if(NOT rc EQUAL 0 AND NOT rc EQUAL 2)
+  message(FATAL_ERROR "${AOC_DAY_EXE} failed (${rc})")
+endif()
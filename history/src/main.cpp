@@ -0,0 +1,111 @@
+#include <aoc/history.hpp>
+#include <fmt/format.h>
+#include <fmt/color.h>
+#include <charconv>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+void printUsage(std::string_view program) {
+    fmt::print("Usage: {} HISTORY [--baseline COMMIT] [--current COMMIT] [--preset NAME] [--threshold PERCENT]\n",
+               program);
+    fmt::print("  HISTORY              file appended to by dayN --history\n");
+    fmt::print("  --baseline COMMIT    commit to compare against (default: the one before --current)\n");
+    fmt::print("  --current COMMIT     commit to check (default: the last one recorded)\n");
+    fmt::print("  --preset NAME        compiler preset to compare (default: {})\n", aoc::buildPreset());
+    fmt::print("  --threshold PERCENT  median change reported as a regression or an improvement (default: 10)\n");
+}
+
+std::optional<double> parsePercent(std::string_view sv) {
+    int value{};
+    const auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), value);
+    if (ec != std::errc{} || ptr != sv.data() + sv.size() || value < 0) return std::nullopt;
+    return value / 100.0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::string_view program = argc > 0 ? argv[0] : "aoc-compare";
+    if (argc < 2) {
+        printUsage(program);
+        return -1;
+    }
+    const std::string filename = argv[1];
+    std::string baseline;
+    std::string current;
+    std::string preset{aoc::buildPreset()};
+    double threshold = 0.10;
+    for (int i = 2; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--baseline" && hasValue) {
+            baseline = argv[++i];
+            continue;
+        } else if (arg == "--current" && hasValue) {
+            current = argv[++i];
+            continue;
+        } else if (arg == "--preset" && hasValue) {
+            preset = argv[++i];
+            continue;
+        } else if (arg == "--threshold" && hasValue) {
+            if (const auto value = parsePercent(argv[i + 1])) {
+                threshold = *value;
+                ++i;
+                continue;
+            }
+        }
+        fmt::print("Invalid argument '{}'\n", arg);
+        printUsage(program);
+        return -1;
+    }
+
+    const auto records = aoc::readHistory(filename);
+    if (!records) {
+        fmt::print("Cannot open '{}'\n", filename);
+        return -1;
+    }
+    if (baseline.empty() || current.empty()) {
+        // Only keep the commits before the one asked for, so --current alone compares it with its predecessor
+        std::vector<aoc::HistoryRecord> upToCurrent;
+        for (const auto& record : *records) {
+            upToCurrent.push_back(record);
+            if (!current.empty() && record.commit == current && record.preset == preset) break;
+        }
+        const auto latest = aoc::latestCommits(upToCurrent, preset);
+        if (!latest) {
+            fmt::print("Fewer than two commits recorded for '{}' in '{}'\n", preset, filename);
+            return -1;
+        }
+        if (baseline.empty()) baseline = latest->first;
+        if (current.empty()) current = latest->second;
+    }
+
+    const auto changes = aoc::compareHistory(*records, preset, baseline, current);
+    if (changes.empty()) {
+        fmt::print("No phase of '{}' was measured at both {} and {}\n", preset, baseline, current);
+        return -1;
+    }
+    fmt::print("{}: {} -> {}, threshold {:.0f}%\n", preset, baseline, current, threshold * 100);
+    int slower{};
+    int faster{};
+    for (const auto& change : changes) {
+        const double ratio = change.ratio();
+        fmt::print("{:<6} {:<6} {:.06f}s -> {:.06f}s  ", change.day, change.part, change.baseline, change.current);
+        if (ratio > 1 + threshold) {
+            fmt::print("{}\n", fmt::styled(fmt::format("{:.2f}x slower", ratio), fmt::fg(fmt::color::orange_red)));
+            ++slower;
+        } else if (ratio < 1 / (1 + threshold)) {
+            fmt::print("{}\n", fmt::styled(fmt::format("{:.2f}x faster", 1 / ratio), fmt::fg(fmt::color::light_green)));
+            ++faster;
+        } else {
+            fmt::print("{:.2f}x\n", ratio);
+        }
+    }
+    fmt::print("\n{} slower, {} faster, {} within the threshold\n", slower, faster,
+               static_cast<int>(changes.size()) - slower - faster);
+    return slower > 0 ? 1 : 0;
+}
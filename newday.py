@@ -12,15 +12,17 @@ def add_day():
     cmakelists = 'CMakeLists.txt'
     os.rename(cmakelists, cmakelists + '.old')
     day_num = 0
+    added = False
     with open(cmakelists + '.old', 'rt') as fin:
         with open(cmakelists, 'wt') as fout:
             for line in fin:
                 if line.startswith('add_subdirectory("day'):
                     day_num = int(line[21:-3])
-                if line.strip() == '' and day_num > 0:
+                if line.strip() == '' and day_num > 0 and not added:
                     day_num += 1
                     fout.write(f'add_subdirectory("day{day_num}")')
                     fout.write('\n')
+                    added = True
                 fout.write(line)
     os.remove(cmakelists + '.old')
     return day_num
@@ -33,4 +35,5 @@ if __name__ == '__main__':
     os.rename(dst + '/src/dayn.cpp', dst + f'/src/day{day_num}.cpp')
     replace_str_in_file(dst + '/CMakeLists.txt', 'dayn', f'day{day_num}')
     replace_str_in_file(dst + f'/src/day{day_num}.cpp', 'dayn', f'day{day_num}')
+    replace_str_in_file(dst + '/src/main.cpp', 'dayn', f'day{day_num}')
 
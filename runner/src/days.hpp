@@ -0,0 +1,7 @@
+#pragma once
+
+#include <aoc/day.hpp>
+#include <vector>
+
+// Every day registered with the AOC_DAYS global property, in configure order. Defined in the generated days.cpp.
+std::vector<const aoc::Day*> getAllDays();
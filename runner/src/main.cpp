@@ -0,0 +1,170 @@
+#include "days.hpp"
+#include <aoc/prefetch.hpp>
+#include <aoc/thread_pool.hpp>
+#include <aoc/trace.hpp>
+#include <fmt/format.h>
+#include <fmt/color.h>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+
+struct DayRun {
+    const aoc::Day* day{};
+    bool test1{};
+    bool test2{};
+    std::optional<std::string_view> text; // prefetched input, nullopt when it cannot be read
+    aoc::Parts parts;
+    std::string answer1;
+    std::string answer2;
+    double parseSeconds{};
+    double part1Seconds{};
+    double part2Seconds{};
+
+    // Time spent working on this day, not counting the wait for a free worker
+    double seconds() const { return parseSeconds + part1Seconds + part2Seconds; }
+};
+
+double secondsSince(Clock::time_point startTime) {
+    return std::chrono::duration<double>(Clock::now() - startTime).count();
+}
+
+fmt::color getTimeColor(double seconds) {
+    return seconds < 0.1 ? fmt::color::light_green : seconds < 1.0 ? fmt::color::orange : fmt::color::orange_red;
+}
+
+std::string styledTime(double seconds) {
+    return fmt::format("{}", fmt::styled(fmt::format("{:.06f}s", seconds), fmt::fg(getTimeColor(seconds))));
+}
+
+void printUsage(std::string_view program) {
+    fmt::print("Usage: {} [--threads N] [--trace FILE] [dayN...]\n", program);
+    fmt::print("  --threads N   worker threads, shared with the parallel parts (default: hardware concurrency)\n");
+    fmt::print("  --trace FILE  write a Chrome trace of samples, parsing and parts to FILE (ui.perfetto.dev)\n");
+    fmt::print("  dayN...       only run these days (default: all)\n");
+}
+
+// Parses on the current worker, then queues part 2 as its own task and runs part 1 here. The parse time includes
+// waiting for the input, when it is not in memory yet.
+void solve(aoc::ThreadPool& pool, aoc::Prefetcher& prefetcher, size_t index, DayRun& run) {
+    const auto parseStart = Clock::now();
+    run.text = prefetcher.text(index);
+    if (!run.text) return;
+    run.parts = run.day->parse(*run.text);
+    run.parseSeconds = secondsSince(parseStart);
+    if (run.test2) {
+        pool.submit([&run] {
+            const auto part2Start = Clock::now();
+            run.answer2 = run.parts.part2();
+            run.part2Seconds = secondsSince(part2Start);
+        });
+    }
+    const auto part1Start = Clock::now();
+    run.answer1 = run.parts.part1();
+    run.part1Seconds = secondsSince(part1Start);
+}
+
+void report(const DayRun& run) {
+    fmt::print("{:<6}", run.day->name);
+    if (!run.test1) {
+        fmt::print("{}\n", fmt::styled("Part 1 sample failed", fmt::fg(fmt::color::red)));
+        return;
+    }
+    if (!run.text) {
+        fmt::print("{}\n", fmt::styled(fmt::format("Cannot open '{}'", run.day->inputFilename),
+                                       fmt::fg(fmt::color::red)));
+        return;
+    }
+    fmt::print("Part 1: {} in {}", fmt::styled(run.answer1, fmt::fg(fmt::color::yellow)),
+               styledTime(run.part1Seconds));
+    if (run.test2) {
+        fmt::print("  Part 2: {} in {}", fmt::styled(run.answer2, fmt::fg(fmt::color::yellow)),
+                   styledTime(run.part2Seconds));
+    } else {
+        fmt::print("  {}", fmt::styled("Part 2 sample failed", fmt::fg(fmt::color::red)));
+    }
+    fmt::print("  total {} (parse {:.06f}s)\n", styledTime(run.seconds()), run.parseSeconds);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::string_view program = argc > 0 ? argv[0] : "aoc-runner";
+    const auto allDays = getAllDays();
+    std::optional<size_t> threadCount;
+    std::string traceFilename;
+    std::vector<DayRun> runs;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            const std::string_view value = argv[++i];
+            size_t n{};
+            const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), n);
+            if (ec == std::errc{} && ptr == value.data() + value.size() && n > 0) {
+                threadCount = n;
+                continue;
+            }
+        } else if (arg == "--trace" && i + 1 < argc) {
+            traceFilename = argv[++i];
+            continue;
+        } else if (auto it = std::ranges::find(allDays, arg, &aoc::Day::name); it != end(allDays)) {
+            runs.emplace_back().day = *it;
+            continue;
+        }
+        fmt::print("Invalid argument '{}'\n", arg);
+        printUsage(program);
+        return -1;
+    }
+    if (runs.empty()) {
+        runs.resize(allDays.size());
+        for (size_t i = 0; i < allDays.size(); ++i) runs[i].day = allDays[i];
+    }
+
+    if (threadCount) aoc::ThreadPool::setSharedSize(*threadCount);
+    const aoc::TraceSession trace{traceFilename};
+    // Every input is read in the background from here on, while the samples run
+    std::vector<std::string> filenames;
+    for (const auto& run : runs) filenames.emplace_back(run.day->inputFilename);
+    aoc::Prefetcher prefetcher{std::move(filenames)};
+    // Samples print as they go, so they run one day at a time before the concurrent part
+    for (auto& run : runs) {
+        fmt::print("{}:\n", run.day->name);
+        std::tie(run.test1, run.test2) = run.day->test();
+    }
+
+    const auto startTime = Clock::now();
+    size_t usedThreads{};
+    {
+        aoc::ThreadPool& pool = aoc::ThreadPool::shared();
+        usedThreads = pool.size();
+        for (size_t i = 0; i < runs.size(); ++i) {
+            if (runs[i].test1)
+                pool.submit([&pool, &prefetcher, i, &run = runs[i]] { solve(pool, prefetcher, i, run); });
+        }
+        pool.wait();
+    }
+    const double wallSeconds = secondsSince(startTime);
+
+    fmt::print("\n");
+    double summedSeconds{};
+    bool allSolved = true;
+    for (const auto& run : runs) {
+        report(run);
+        allSolved &= run.test1 && run.test2 && run.text.has_value();
+        summedSeconds += run.seconds();
+    }
+    fmt::print("\n{} days in {} wall, {:.06f}s summed over days ({:.2f}x) on {} threads\n", runs.size(),
+               styledTime(wallSeconds), summedSeconds, wallSeconds > 0 ? summedSeconds / wallSeconds : 0.0,
+               usedThreads);
+    return allSolved ? 0 : 1;
+}
@@ -0,0 +1,10 @@
+#include <aoc/day.hpp>
+
+namespace dayn
+{
+const aoc::Day& getDay();
+} // namespace dayn
+
+int main(int argc, char* argv[]) {
+    return aoc::runDay(dayn::getDay(), argc, argv);
+}
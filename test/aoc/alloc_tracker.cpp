@@ -0,0 +1,35 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/alloc_tracker.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+TEST_CASE("AllocationTracker counts allocations, bytes and peak") {
+    struct alignas(64) Aligned {
+        std::array<char, 100> data;
+    };
+    bool isAligned{};
+    aoc::AllocationTracker tracker;
+    tracker.start(); // no REQUIRE until stop(), Catch may allocate
+    {
+        std::vector<std::unique_ptr<std::array<char, 1000>>> blocks;
+        blocks.reserve(4);
+        for (int i = 0; i < 4; ++i) blocks.push_back(std::make_unique<std::array<char, 1000>>());
+        const auto aligned = std::make_unique<Aligned>();
+        isAligned = reinterpret_cast<uintptr_t>(aligned.get()) % 64 == 0;
+    }
+    const auto stats = tracker.stop();
+    REQUIRE(isAligned);
+    if (!aoc::AllocationTracker::enabled()) {
+        REQUIRE(stats.count == 0);
+        return;
+    }
+    REQUIRE(stats.count == 6);
+    REQUIRE(stats.bytes == 4 * sizeof(void*) + 4000 + sizeof(Aligned));
+    REQUIRE(stats.peakBytes == stats.bytes);
+
+    tracker.start();
+    REQUIRE(tracker.stop().count == 0);
+}
@@ -0,0 +1,61 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/batch.hpp>
+#include <aoc/thread_pool.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+aoc::Day makeLengthDay() {
+    auto parse = [](std::string_view text) { return std::string{text}; };
+    return aoc::makeDay(
+        "day0", "day0.txt", {}, parse, [](const std::string& input) { return input.size(); },
+        [](const std::string& input) { return input + input; });
+}
+
+} // namespace
+
+TEST_CASE("expandInputs keeps files and lists directories in name order") {
+    const std::filesystem::path dir = "test-aoc-batch";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "nested");
+    for (const auto* name : {"b.txt", "a.txt"}) std::ofstream{dir / name} << name;
+
+    const auto inputs = aoc::expandInputs({"single.txt", dir.string()});
+    REQUIRE(inputs == std::vector<std::string>{"single.txt", (dir / "a.txt").string(), (dir / "b.txt").string()});
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("solveBatch solves every input in order") {
+    const std::filesystem::path dir = "test-aoc-batch";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    std::vector<std::string> filenames;
+    for (int i = 0; i < 20; ++i) {
+        filenames.push_back((dir / std::to_string(i)).string());
+        std::ofstream{filenames.back(), std::ios::binary} << std::string(i, 'x');
+    }
+    filenames.push_back((dir / "missing").string());
+
+    const aoc::Day day = makeLengthDay();
+    aoc::ThreadPool pool{4};
+    const auto results = aoc::solveBatch(day, filenames, true, pool);
+    REQUIRE(results.size() == filenames.size());
+    for (size_t i = 0; i < 20; ++i) {
+        REQUIRE(results[i].opened);
+        REQUIRE(results[i].bytes == i);
+        REQUIRE(results[i].answer1 == std::to_string(i));
+        REQUIRE(results[i].answer2 == std::string(2 * i, 'x'));
+    }
+    REQUIRE_FALSE(results.back().opened);
+
+    REQUIRE(aoc::solveBatch(day, {filenames[3]}, false, pool).front().answer2.empty());
+    REQUIRE(aoc::runBatch(day, true, {dir.string(), filenames.back()}, 2) == -1);
+    REQUIRE(aoc::runBatch(day, true, {dir.string()}, 2) == 0);
+    REQUIRE(aoc::runBatch(day, false, {dir.string()}, 2) == 2);
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,93 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/bench.hpp>
+
+#include <array>
+
+TEST_CASE("computeStats uses nearest-rank percentiles") {
+    std::vector<double> samples;
+    for (int i = 100; i >= 1; --i) samples.push_back(i / 1000.0);
+    const auto stats = aoc::computeStats(samples, 1000);
+    REQUIRE(stats.samples == 100);
+    REQUIRE(stats.min == 0.001);
+    REQUIRE(stats.median == 0.050);
+    REQUIRE(stats.p95 == 0.095);
+    REQUIRE(stats.p99 == 0.099);
+    REQUIRE(stats.bytesPerSecond == 1000 / 0.050);
+}
+
+TEST_CASE("computeStats of a single sample") {
+    const auto stats = aoc::computeStats({0.25}, 0);
+    REQUIRE(stats.samples == 1);
+    REQUIRE(stats.min == 0.25);
+    REQUIRE(stats.median == 0.25);
+    REQUIRE(stats.p99 == 0.25);
+    REQUIRE(stats.bytesPerSecond == 0.0);
+}
+
+TEST_CASE("BenchOptions::fromArgs") {
+    std::array<char*, 7> argv{const_cast<char*>("day1"), const_cast<char*>("--warmup"), const_cast<char*>("2"),
+                              const_cast<char*>("--reps"),  const_cast<char*>("10"),       const_cast<char*>("--json"),
+                              const_cast<char*>("out.json")};
+    const auto opts = aoc::BenchOptions::fromArgs(static_cast<int>(argv.size()), argv.data());
+    REQUIRE(opts);
+    REQUIRE(opts->warmup == 2);
+    REQUIRE(opts->repetitions == 10);
+    REQUIRE(opts->jsonFilename == "out.json");
+    REQUIRE_FALSE(opts->counters);
+    REQUIRE(opts->inputs.empty());
+
+    std::array<char*, 2> countersArgv{argv[0], const_cast<char*>("--counters")};
+    REQUIRE(aoc::BenchOptions::fromArgs(2, countersArgv.data())->counters);
+    REQUIRE(aoc::BenchOptions::fromArgs(2, countersArgv.data())->sharedPoolSize(true) == 0u);
+    REQUIRE_FALSE(aoc::BenchOptions::fromArgs(2, countersArgv.data())->sharedPoolSize(false));
+    REQUIRE_FALSE(opts->sharedPoolSize(true));
+    std::array<char*, 3> traceArgv{argv[0], const_cast<char*>("--trace"), const_cast<char*>("trace.json")};
+    REQUIRE(aoc::BenchOptions::fromArgs(3, traceArgv.data())->traceFilename == "trace.json");
+    REQUIRE_FALSE(opts->sequential);
+    std::array<char*, 2> sequentialArgv{argv[0], const_cast<char*>("--sequential")};
+    REQUIRE(aoc::BenchOptions::fromArgs(2, sequentialArgv.data())->sequential);
+    std::array<char*, 4> streamArgv{argv[0], const_cast<char*>("--stream"), const_cast<char*>("--chunk"),
+                                    const_cast<char*>("4096")};
+    const auto stream = aoc::BenchOptions::fromArgs(4, streamArgv.data());
+    REQUIRE(stream->stream);
+    REQUIRE(stream->chunkSize == 4096);
+    REQUIRE(opts->measures());
+    REQUIRE_FALSE(aoc::BenchOptions::fromArgs(1, argv.data())->measures());
+    REQUIRE(opts->cacheDirectory == ".aoc-cache");
+    REQUIRE_FALSE(opts->verifyCache);
+    std::array<char*, 3> noCacheArgv{argv[0], const_cast<char*>("--no-cache"), const_cast<char*>("--verify-cache")};
+    const auto noCache = aoc::BenchOptions::fromArgs(3, noCacheArgv.data());
+    REQUIRE(noCache->cacheDirectory.empty());
+    REQUIRE(noCache->verifyCache);
+    std::array<char*, 3> cacheArgv{argv[0], const_cast<char*>("--cache"), const_cast<char*>("answers")};
+    REQUIRE(aoc::BenchOptions::fromArgs(3, cacheArgv.data())->cacheDirectory == "answers");
+    REQUIRE_FALSE(opts->check);
+    std::array<char*, 3> checkArgv{argv[0], const_cast<char*>("--check"), const_cast<char*>("inputs")};
+    const auto check = aoc::BenchOptions::fromArgs(3, checkArgv.data());
+    REQUIRE(check->check);
+    REQUIRE(check->inputs == std::vector<std::string>{"inputs"});
+    REQUIRE(opts->profileFilename.empty());
+    std::array<char*, 3> profileArgv{argv[0], const_cast<char*>("--profile"), const_cast<char*>("day.folded")};
+    const auto profile = aoc::BenchOptions::fromArgs(3, profileArgv.data());
+    REQUIRE(profile->profileFilename == "day.folded");
+    REQUIRE(profile->measures());
+    REQUIRE_FALSE(opts->memory);
+    std::array<char*, 4> memoryArgv{argv[0], const_cast<char*>("--memory"), const_cast<char*>("--memory-limit"),
+                                    const_cast<char*>("512")};
+    const auto memory = aoc::BenchOptions::fromArgs(4, memoryArgv.data());
+    REQUIRE(memory->memory);
+    REQUIRE(memory->memoryLimit == 512'000'000);
+    REQUIRE(memory->measures());
+
+    REQUIRE_FALSE(aoc::BenchOptions::fromArgs(3, std::array{argv[0], argv[3], argv[1]}.data()));
+    REQUIRE_FALSE(aoc::BenchOptions::fromArgs(2, std::array{argv[0], argv[3]}.data()));
+
+    std::array<char*, 5> batchArgv{argv[0], const_cast<char*>("a.txt"), const_cast<char*>("--threads"),
+                                   const_cast<char*>("3"), const_cast<char*>("inputs")};
+    const auto batch = aoc::BenchOptions::fromArgs(static_cast<int>(batchArgv.size()), batchArgv.data());
+    REQUIRE(batch);
+    REQUIRE(batch->inputs == std::vector<std::string>{"a.txt", "inputs"});
+    REQUIRE(batch->threads == 3);
+    REQUIRE(batch->sharedPoolSize(true) == 3u);
+    REQUIRE_FALSE(aoc::BenchOptions::fromArgs(3, std::array{argv[0], batchArgv[2], argv[0]}.data()));
+}
@@ -0,0 +1,64 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/check.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+std::string parseText(std::string_view text) {
+    return std::string{text};
+}
+
+// Digit sum, the "optimized" one goes wrong on inputs holding a 9
+int digitSum(const std::string& input) {
+    int res{};
+    for (char ch : input) res += ch - '0';
+    return res;
+}
+int fastDigitSum(const std::string& input) {
+    int res{};
+    for (char ch : input) res += ch == '9' ? 0 : ch - '0';
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("checkReferences compares every part that has a reference") {
+    auto length = [](const std::string& input) { return input.size(); };
+    const aoc::Day plain = aoc::makeDay(
+        "day0", "test-aoc-check-day0.txt",
+        {aoc::makeSample(1, "123", 6, parseText, fastDigitSum), aoc::makeSample(2, "45", 2, parseText, length)},
+        parseText, fastDigitSum, length);
+    REQUIRE(plain.references.empty());
+    REQUIRE(aoc::runCheck(plain, {}) == -1);
+
+    const aoc::Day day = aoc::withReference(plain, 1, parseText, digitSum);
+    REQUIRE(day.references.size() == 1);
+    REQUIRE(day.references.front().solve("99") == "18");
+
+    const std::string extra = "test-aoc-check-extra.txt";
+    std::ofstream{std::string{day.inputFilename}, std::ios::binary} << "1234";
+    std::ofstream{extra, std::ios::binary} << "19";
+    auto results = aoc::checkReferences(day, {extra, "test-aoc-check-missing.txt"});
+    REQUIRE(results.size() == 4);
+    REQUIRE(results[0].input == "sample 1");
+    REQUIRE(results[0].agrees());
+    REQUIRE(results[1].input == day.inputFilename);
+    REQUIRE(results[1].answer == "10");
+    REQUIRE(results[1].agrees());
+    REQUIRE(results[2].opened);
+    REQUIRE(results[2].answer == "1");
+    REQUIRE(results[2].referenceAnswer == "10");
+    REQUIRE_FALSE(results[2].agrees());
+    REQUIRE_FALSE(results[3].opened);
+    REQUIRE_FALSE(results[3].agrees());
+
+    REQUIRE(aoc::runCheck(day, {}) == 0);
+    REQUIRE(aoc::runCheck(day, {extra}) == -1);
+    std::remove(extra.c_str());
+    std::remove(std::string{day.inputFilename}.c_str());
+}
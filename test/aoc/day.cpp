@@ -0,0 +1,127 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/day.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+std::vector<int> parseTwos(std::string_view text) {
+    return std::vector<int>(text.size(), 2);
+}
+
+// Sum of the record lengths and longest record, copied since the records are views of a chunk
+struct LengthFold {
+    size_t total{};
+    std::string longest;
+
+    void add(std::string_view record) {
+        total += record.size();
+        if (record.size() > longest.size()) longest = record;
+    }
+    size_t part1() const { return total; }
+    std::string part2() const { return longest; }
+};
+
+} // namespace
+
+TEST_CASE("makeDay parses once and formats both answers") {
+    int parseCount = 0;
+    const aoc::Day day = aoc::makeDay(
+        "day0", "day0.txt", {},
+        [&](std::string_view text) {
+            ++parseCount;
+            return parseTwos(text);
+        },
+        [](const std::vector<int>& input) { return input.size(); },
+        [](const std::vector<int>& input) { return std::to_string(input.back()) + "!"; });
+    REQUIRE(day.name == "day0");
+    REQUIRE(day.hasPart2);
+    const auto parts = day.parse("abc");
+    REQUIRE(parts.part1() == "3");
+    REQUIRE(parts.part2() == "2!");
+    REQUIRE(parseCount == 1);
+}
+
+TEST_CASE("makeSample drops the newline opening a raw string") {
+    const auto sample = aoc::makeSample(1, R"(
+ab)", 2, parseTwos, [](const std::vector<int>& input) { return input.size(); });
+    REQUIRE(sample.part == 1);
+    REQUIRE(sample.input == "ab");
+    REQUIRE(sample.answer == "2");
+    REQUIRE(sample.parse(sample.input)() == "2");
+}
+
+TEST_CASE("test() passes a part when all of its samples do") {
+    auto size = [](const std::vector<int>& input) { return input.size(); };
+    auto sum = [](const std::vector<int>& input) { return input.empty() ? 0 : input[0] * input.size(); };
+    std::vector<aoc::Sample> samples{aoc::makeSample(1, "abc", 3, parseTwos, size),
+                                     aoc::makeSample(2, "ab", 4, parseTwos, sum)};
+    aoc::Day day = aoc::makeDay("day0", "day0.txt", samples, parseTwos, size, sum);
+    REQUIRE(day.test() == std::pair{true, true});
+
+    day.samples.push_back(aoc::makeSample(2, "a", 3, parseTwos, sum));
+    REQUIRE(day.test() == std::pair{true, false});
+}
+
+TEST_CASE("test() skips samples checked at build time") {
+    auto size = [](const std::vector<int>& input) { return input.size(); };
+    const aoc::Day day = aoc::makeDay(
+        "day0", "day0.txt", {aoc::checkedAtBuild(aoc::makeSample(1, "abc", 4, parseTwos, size))}, parseTwos, size,
+        size);
+    REQUIRE(day.samples.front().checkedAtBuild);
+    REQUIRE(day.test() == std::pair{true, true});
+    STATIC_REQUIRE(aoc::sampleText("\nab") == "ab");
+}
+
+TEST_CASE("A day without part 2 never passes it") {
+    auto size = [](const std::vector<int>& input) { return input.size(); };
+    const aoc::Day day = aoc::makeDay("day0", "day0.txt", {aoc::makeSample(1, "abc", 3, parseTwos, size)}, parseTwos,
+                                      size);
+    REQUIRE_FALSE(day.hasPart2);
+    REQUIRE_FALSE(day.parse("abc").part2);
+    REQUIRE(day.test() == std::pair{true, false});
+}
+
+TEST_CASE("Parsers and parts taking a memory resource get their own arena") {
+    std::pmr::memory_resource* parseArena{};
+    std::vector<std::pmr::memory_resource*> partArenas;
+    const aoc::Day day = aoc::makeDay(
+        "day0", "day0.txt", {},
+        [&](std::string_view text, std::pmr::memory_resource* arena) {
+            parseArena = arena;
+            return std::pmr::vector<int>(text.size(), 2, arena);
+        },
+        [&](const std::pmr::vector<int>& input, std::pmr::memory_resource* arena) {
+            partArenas.push_back(arena);
+            return input.get_allocator().resource() == parseArena;
+        },
+        [](const std::pmr::vector<int>& input) { return input.size(); });
+    const auto parts = day.parse("abc");
+    REQUIRE(parseArena != nullptr);
+    REQUIRE(parseArena != std::pmr::get_default_resource());
+    REQUIRE(parts.part1() == "true");
+    REQUIRE(parts.part1() == "true");
+    REQUIRE(parts.part2() == "3");
+    REQUIRE(partArenas.size() == 2);
+    REQUIRE(partArenas[0] != nullptr);
+    REQUIRE(partArenas[0] != parseArena);
+}
+
+TEST_CASE("withStream folds the records of a file chunk by chunk") {
+    auto size = [](const std::vector<int>& input) { return input.size(); };
+    const aoc::Day day = aoc::withStream<LengthFold>(aoc::makeDay("day0", "day0.txt", {}, parseTwos, size), ",\n");
+    REQUIRE_FALSE(aoc::makeDay("day0", "day0.txt", {}, parseTwos, size).stream);
+    REQUIRE(day.stream);
+
+    const std::string filename = "test-aoc-stream.txt";
+    std::ofstream{filename, std::ios::binary} << "ab,cde,f\nghij\n";
+    for (size_t chunkSize : {1, 3, 64})
+        REQUIRE(day.stream(filename, chunkSize) == std::pair<std::string, std::string>{"10", "ghij"});
+    std::remove(filename.c_str());
+    REQUIRE_FALSE(day.stream(filename, 64));
+}
@@ -0,0 +1,121 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/flat_hash_map.hpp>
+#include <fmt/format.h>
+
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+TEST_CASE("hashValues depends on every value and their order") {
+    REQUIRE(aoc::hashValues(1, 2) != aoc::hashValues(2, 1));
+    REQUIRE(aoc::hashValues(1, 2, 3) == aoc::Hash<std::tuple<int, int, int>>{}({1, 2, 3}));
+    REQUIRE(aoc::Hash<std::pair<int, int>>{}({-1, 0}) != aoc::Hash<std::pair<int, int>>{}({0, -1}));
+    REQUIRE(aoc::Hash<std::string>{}("O.O#") == aoc::Hash<std::string_view>{}("O.O#"));
+    REQUIRE(aoc::hashBytes("abcdefgh") != aoc::hashBytes("abcdefgh."));
+    REQUIRE(aoc::hashBytes("") != aoc::hashBytes(std::string_view{"\0", 1}));
+    // Consecutive integers spread over the low bits a table indexes by
+    std::unordered_set<size_t> lowBits;
+    for (int i = 0; i < 64; ++i) lowBits.insert(aoc::Hash<int>{}(i) & 0xff);
+    REQUIRE(lowBits.size() > 32);
+}
+
+TEST_CASE("FlatHashMap inserts, finds and erases like std::unordered_map") {
+    aoc::FlatHashMap<std::pair<int, int>, int> map;
+    std::unordered_map<int64_t, int> expected;
+    REQUIRE(map.empty());
+    REQUIRE(map.find({0, 0}) == map.end());
+    for (int i = 0; i < 5000; ++i) {
+        const std::pair<int, int> key{i % 71, i / 71};
+        REQUIRE(map.try_emplace(key, i).second);
+        REQUIRE_FALSE(map.try_emplace(key, -1).second);
+        expected[i] = i;
+    }
+    REQUIRE(map.size() == 5000);
+    for (int i = 0; i < 5000; i += 2) REQUIRE(map.erase({i % 71, i / 71}) == 1);
+    REQUIRE(map.erase({-1, -1}) == 0);
+    REQUIRE(map.size() == 2500);
+    for (int i = 0; i < 5000; ++i) REQUIRE(map.contains({i % 71, i / 71}) == (i % 2 == 1));
+    map[{1000, 1000}] += 3;
+    REQUIRE(map.find({1000, 1000})->second == 3);
+
+    int64_t sum{};
+    for (const auto& [key, value] : map) sum += value;
+    REQUIRE(sum == 2500LL * 2500 + 3);
+
+    const auto copy = map;
+    map.clear();
+    REQUIRE(map.empty());
+    REQUIRE(copy.size() == 2501);
+    REQUIRE(copy.count({1, 0}) == 1);
+    const auto stats = copy.probeStats();
+    REQUIRE(stats.size == 2501);
+    REQUIRE(stats.tombstones >= 2499); // operator[] may have reused one
+    REQUIRE(stats.loadFactor <= 0.875);
+    REQUIRE(stats.meanProbeLength >= 1.0);
+}
+
+TEST_CASE("FlatHashSet reuses tombstones") {
+    aoc::FlatHashSet<std::string> set;
+    set.reserve(100);
+    for (int round = 0; round < 1000; ++round) {
+        REQUIRE(set.insert(std::to_string(round)).second);
+        REQUIRE_FALSE(set.insert(std::to_string(round)).second);
+        REQUIRE(set.erase(std::to_string(round)) == 1);
+    }
+    REQUIRE(set.empty());
+    REQUIRE(set.probeStats().capacity <= 128);
+    aoc::FlatHashSet<int> moved = [] {
+        aoc::FlatHashSet<int> ints;
+        for (int i = 0; i < 100; ++i) ints.insert(i * 7);
+        return ints;
+    }();
+    REQUIRE(moved.size() == 100);
+    REQUIRE(moved.contains(693));
+}
+
+// Hidden, run with the [benchmark] tag. Key sets shaped like those of the hash-heavy days on the real input and on one
+// 10x its size (see aoc-gen): day 21 part 2 visits a diamond of garden plots, day 22 fills a column of 3D blocks.
+TEST_CASE("FlatHashMap benchmarks", "[.][benchmark]") {
+    auto diamond = [](int radius) {
+        std::vector<std::pair<int, int>> res;
+        for (int r = -radius; r <= radius; ++r)
+            for (int c = -(radius - std::abs(r)); c <= radius - std::abs(r); ++c) res.emplace_back(r, c);
+        return res;
+    };
+    auto blocks = [](int bricks) {
+        std::vector<std::tuple<int, int, int>> res;
+        for (int i = 0; i < bricks; ++i)
+            for (int dz = 0; dz < 3; ++dz) res.emplace_back(i % 10, i / 10 % 10, i / 100 * 3 + dz);
+        return res;
+    };
+    auto run = [](std::string_view name, const auto& keys) {
+        using Key = typename std::decay_t<decltype(keys)>::value_type;
+        aoc::FlatHashMap<Key, int> flat;
+        for (const auto& key : keys) flat[key] = 1;
+        const auto stats = flat.probeStats();
+        fmt::print("{}: {} keys, capacity {}, load factor {:.3f}, mean probe length {:.3f} groups, max {}\n", name,
+                   stats.size, stats.capacity, stats.loadFactor, stats.meanProbeLength, stats.maxProbeLength);
+        BENCHMARK(fmt::format("{} FlatHashMap insert and find", name)) {
+            aoc::FlatHashMap<Key, int> map;
+            for (const auto& key : keys) map[key] = 1;
+            int found{};
+            for (const auto& key : keys) found += map.find(key)->second;
+            return found;
+        };
+        BENCHMARK(fmt::format("{} std::unordered_map insert and find", name)) {
+            std::unordered_map<Key, int, aoc::Hash<Key>> map;
+            for (const auto& key : keys) map[key] = 1;
+            int found{};
+            for (const auto& key : keys) found += map.find(key)->second;
+            return found;
+        };
+    };
+    for (int scale : {1, 10}) {
+        run(fmt::format("day21 {}x", scale), diamond(static_cast<int>(327 * std::sqrt(scale))));
+        run(fmt::format("day22 {}x", scale), blocks(1200 * scale));
+    }
+}
@@ -0,0 +1,52 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/graph.hpp>
+
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+template <class Weight>
+std::vector<std::pair<uint32_t, Weight>> edgesOf(const aoc::CsrGraph<Weight>& graph, uint32_t from) {
+    std::vector<std::pair<uint32_t, Weight>> res;
+    for (const auto& [to, weight] : graph.edges(from)) res.emplace_back(to, weight);
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("GraphBuilder gives names dense ids and keeps edges in insertion order") {
+    aoc::GraphBuilder<> builder;
+    const uint32_t aaa = builder.vertex("AAA");
+    builder.addEdge(aaa, builder.vertex("BBB"));
+    builder.addEdge(builder.vertex("CCC"), aaa, 5);
+    builder.addEdge(aaa, builder.vertex("CCC"), 2);
+    REQUIRE(builder.vertex("BBB") == 1);
+    REQUIRE(builder.size() == 3);
+
+    const auto graph = builder.build();
+    REQUIRE(graph.size() == 3);
+    REQUIRE(graph.edgeCount() == 3);
+    REQUIRE(edgesOf(graph, aaa) == std::vector<std::pair<uint32_t, int>>{{1, 1}, {2, 2}});
+    REQUIRE(graph.edges(1).empty());
+    REQUIRE(edgesOf(graph, 2) == std::vector<std::pair<uint32_t, int>>{{0, 5}});
+    REQUIRE(graph.name(2) == "CCC");
+    REQUIRE(graph.find("BBB") == 1u);
+    REQUIRE_FALSE(graph.find("ZZZ"));
+}
+
+TEST_CASE("GraphBuilder with unnamed vertices and undirected edges") {
+    aoc::GraphBuilder<int64_t> builder{2};
+    builder.addUndirectedEdge(0, 3, 7);
+    std::pmr::monotonic_buffer_resource arena;
+    const auto graph = builder.build(&arena);
+    REQUIRE(graph.size() == 4);
+    REQUIRE(graph.edgeCount() == 2);
+    REQUIRE(edgesOf(graph, 0) == std::vector<std::pair<uint32_t, int64_t>>{{3, 7}});
+    REQUIRE(edgesOf(graph, 3) == std::vector<std::pair<uint32_t, int64_t>>{{0, 7}});
+    REQUIRE(graph.edges(2).empty());
+    REQUIRE(graph.name(3).empty());
+    REQUIRE(aoc::CsrGraph<>{}.size() == 0);
+}
@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/grid.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST_CASE("Grid keeps rows contiguous inside a sentinel border") {
+    const std::vector<std::string_view> lines{"ab", "cd", "ef"};
+    const auto grid = aoc::Grid<char>::fromLines(lines, 1, '#');
+    REQUIRE(grid.rows() == 3);
+    REQUIRE(grid.cols() == 2);
+    REQUIRE(grid.stride() == 4);
+    REQUIRE(grid.storage().size() == 20);
+    REQUIRE(grid(0, 0) == 'a');
+    REQUIRE(grid(2, 1) == 'f');
+    REQUIRE(grid(-1, 0) == '#');
+    REQUIRE(grid(1, 2) == '#');
+    REQUIRE(std::ranges::equal(grid.row(1), std::string_view{"cd"}));
+    REQUIRE(grid.position(grid.index(2, 1)) == std::pair{2, 1});
+    REQUIRE(grid.contains(2, 1));
+    REQUIRE_FALSE(grid.contains(3, 0));
+}
+
+TEST_CASE("Grid neighbors are flat index offsets") {
+    const auto grid = aoc::Grid<char>::fromLines({"abc", "def", "ghi"}, 1, '#');
+    const size_t center = grid.index(1, 1);
+    std::string neighbors;
+    for (ptrdiff_t offset : grid.offsets4()) neighbors += grid[center + offset];
+    REQUIRE(neighbors == "bfhd");
+    neighbors.clear();
+    for (ptrdiff_t offset : grid.offsets8()) neighbors += grid[grid.index(0, 0) + offset];
+    REQUIRE(neighbors == "#bd####e");
+}
+
+TEST_CASE("Grid fromLines rejects lines of another length") {
+    REQUIRE_THROWS_AS(aoc::Grid<char>::fromLines({"abc", "defg", "hi"}), std::invalid_argument);
+    REQUIRE_THROWS_AS(aoc::Grid<char>::fromLines({"abc", "de"}, 1, '#'), std::invalid_argument);
+    REQUIRE(aoc::Grid<char>::fromLines({}).rows() == 0);
+}
+
+TEST_CASE("Grid shapedLike shares indices") {
+    const aoc::Grid<char> grid(2, 3, '.', 2, '#');
+    auto visited = aoc::Grid<uint8_t>::shapedLike(grid, 0, 1);
+    REQUIRE(visited.stride() == grid.stride());
+    visited[grid.index(1, 2)] = 1;
+    REQUIRE(visited(1, 2) == 1);
+    REQUIRE(visited(-2, -2) == 1);
+    REQUIRE(visited(0, 0) == 0);
+    auto copy = visited;
+    REQUIRE(copy == visited);
+    copy(0, 0) = 1;
+    REQUIRE_FALSE(copy == visited);
+}
@@ -0,0 +1,73 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/bench.hpp>
+#include <aoc/history.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+aoc::HistoryRecord record(std::string commit, std::string day, std::string part, double median) {
+    return {std::move(commit), "linux.gcc", std::move(day), std::move(part), median};
+}
+
+} // namespace
+
+TEST_CASE("Bench appends history records that read back") {
+    const std::string filename = "test-aoc-history.jsonl";
+    std::remove(filename.c_str());
+    for (int run = 0; run < 2; ++run) {
+        aoc::BenchOptions options;
+        options.historyFilename = filename;
+        aoc::Bench bench{"day0", "day0.txt", options};
+        bench.run("Part 1", [] { return 42; });
+    }
+    const auto records = aoc::readHistory(filename);
+    REQUIRE(records);
+    REQUIRE(records->size() == 2);
+    const auto& first = records->front();
+    REQUIRE(first.commit == aoc::buildCommit());
+    REQUIRE(first.preset == aoc::buildPreset());
+    REQUIRE(first.day == "day0");
+    REQUIRE(first.part == "Part 1");
+    REQUIRE(first.median >= 0.0);
+    std::remove(filename.c_str());
+    REQUIRE_FALSE(aoc::readHistory(filename));
+}
+
+TEST_CASE("parseHistoryRecord") {
+    const auto parsed = aoc::parseHistoryRecord(R"({"commit": "abc", "preset": "linux.clang", "day": "day\"1", )"
+                                                R"("input": "day1.txt", "part": "Parse", "median": 0.000012500})");
+    REQUIRE(parsed);
+    REQUIRE(parsed->commit == "abc");
+    REQUIRE(parsed->preset == "linux.clang");
+    REQUIRE(parsed->day == "day\"1");
+    REQUIRE(parsed->part == "Parse");
+    REQUIRE(parsed->median == 0.0000125);
+    REQUIRE_FALSE(aoc::parseHistoryRecord(R"({"input": "day1.txt", "part": "Parse", "median": 0.1})"));
+    REQUIRE_FALSE(aoc::parseHistoryRecord(""));
+}
+
+TEST_CASE("compareHistory pairs the phases measured at both commits") {
+    std::vector<aoc::HistoryRecord> records{record("a", "day2", "Part 1", 0.010), record("a", "day1", "Part 1", 0.100),
+                                            record("a", "day1", "Part 2", 1.000), record("b", "day1", "Part 1", 0.300),
+                                            record("b", "day2", "Part 1", 0.010), record("b", "day1", "Part 1", 0.200),
+                                            record("c", "day1", "Part 1", 0.001)};
+    records.push_back({"b", "linux.clang", "day1", "Part 2", 5.0});
+
+    const auto latest = aoc::latestCommits(records, "linux.gcc");
+    REQUIRE(latest == std::pair<std::string, std::string>{"b", "c"});
+    REQUIRE(aoc::latestCommits(records, "linux.clang") == std::nullopt);
+
+    const auto changes = aoc::compareHistory(records, "linux.gcc", "a", "b");
+    REQUIRE(changes.size() == 2);
+    REQUIRE(changes[0].day == "day2");
+    REQUIRE(changes[0].ratio() == 1.0);
+    REQUIRE(changes[1].day == "day1");
+    REQUIRE(changes[1].part == "Part 1");
+    REQUIRE(changes[1].baseline == 0.100);
+    REQUIRE(changes[1].current == 0.200);
+    REQUIRE(changes[1].ratio() == 2.0);
+}
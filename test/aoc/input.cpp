@@ -0,0 +1,70 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/input.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("splitLines handles LF, CRLF and a missing final newline") {
+    using V = std::vector<std::string_view>;
+    REQUIRE(aoc::splitLines("") == V{});
+    REQUIRE(aoc::splitLines("ab\ncd\n") == V{"ab", "cd"});
+    REQUIRE(aoc::splitLines("ab\r\ncd\r\n") == V{"ab", "cd"});
+    REQUIRE(aoc::splitLines("ab\r\n\r\ncd") == V{"ab", "", "cd"});
+    REQUIRE(aoc::splitLines("\n") == V{""});
+}
+
+TEST_CASE("forEachRecord splits on any of the separators") {
+    std::vector<std::string_view> records;
+    aoc::forEachRecord("rn=1,cm-\r\nqp=3,", ",\n", [&](std::string_view record) { records.push_back(record); });
+    REQUIRE(records == std::vector<std::string_view>{"rn=1", "cm-", "qp=3"});
+}
+
+TEST_CASE("ChunkReader never cuts a record") {
+    const std::string filename = "test-aoc-chunk-reader.txt";
+    std::string text;
+    for (int i = 0; i < 1000; ++i) text += std::to_string(i * 7919) + (i % 3 ? "\n" : "\r\n");
+    text += "a record longer than the chunk, without a final newline";
+    std::ofstream{filename, std::ios::binary} << text;
+    for (size_t chunkSize : {1, 5, 16, 4096}) {
+        aoc::ChunkReader reader{filename, "\n", chunkSize};
+        REQUIRE(reader);
+        std::string joined;
+        std::vector<std::string> lines; // copies, the chunk is overwritten by the next one
+        for (std::string_view chunk; !(chunk = reader.next()).empty();) {
+            joined += chunk;
+            aoc::forEachRecord(chunk, "\n", [&](std::string_view line) {
+                if (lines.size() < 3 || line.starts_with('a')) lines.emplace_back(line);
+            });
+            REQUIRE((chunk.ends_with('\n') || joined.size() == text.size()));
+        }
+        REQUIRE(joined == text);
+        REQUIRE(lines == std::vector<std::string>{"0", "7919", "15838", text.substr(text.rfind('\n') + 1)});
+    }
+    std::remove(filename.c_str());
+    REQUIRE_FALSE(aoc::ChunkReader(filename, "\n", 16));
+    REQUIRE_FALSE(aoc::ChunkReader(".", "\n", 16));
+}
+
+TEST_CASE("MappedFile exposes the file content") {
+    const std::string filename = "test-aoc-mapped-file.txt";
+    std::ofstream{filename, std::ios::binary} << "12 34\r\n56\r\n";
+    {
+        aoc::MappedFile file{filename};
+        REQUIRE(file);
+        REQUIRE(file.text() == "12 34\r\n56\r\n");
+        const aoc::MappedFile moved{std::move(file)};
+        REQUIRE_FALSE(file);
+        REQUIRE(moved);
+        REQUIRE(aoc::splitLines(moved.text()).size() == 2);
+    }
+    std::ofstream{filename, std::ios::binary | std::ios::trunc};
+    {
+        const aoc::MappedFile file{filename};
+        REQUIRE(file);
+        REQUIRE(file.text().empty());
+    }
+    std::remove(filename.c_str());
+    REQUIRE_FALSE(aoc::MappedFile{filename});
+}
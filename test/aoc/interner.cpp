@@ -0,0 +1,31 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/interner.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST_CASE("Interner gives names dense ids in order of first use") {
+    aoc::Interner names{"A", "R"};
+    REQUIRE(names.size() == 2);
+    REQUIRE(names.intern("R") == 1);
+    REQUIRE(names.intern("px") == 2);
+    REQUIRE(names.intern("qkq") == 3);
+    REQUIRE(names.intern("px") == 2);
+    REQUIRE(names.find("qkq") == 3u);
+    REQUIRE_FALSE(names.find("in"));
+    REQUIRE(names.name(2) == "px");
+    REQUIRE(names.symbols() == std::vector<std::string_view>{"A", "R", "px", "qkq"});
+}
+
+TEST_CASE("Interner keeps its ids through rehashes") {
+    std::vector<std::string> text;
+    for (int i = 0; i < 5000; ++i) text.push_back("n" + std::to_string(i));
+    aoc::Interner names;
+    for (const auto& name : text) names.intern(name);
+    REQUIRE(names.size() == text.size());
+    for (uint32_t id = 0; id < text.size(); id += 97) {
+        REQUIRE(names.find(text[id]) == id);
+        REQUIRE(names.name(id) == text[id]);
+    }
+}
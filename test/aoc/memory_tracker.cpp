@@ -0,0 +1,30 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/memory_tracker.hpp>
+
+#include <cstddef>
+#include <memory>
+
+TEST_CASE("MemoryTracker sees the pages a phase touches") {
+    constexpr size_t kBytes = size_t{64} << 20;
+    aoc::MemoryTracker tracker;
+    tracker.start();
+    {
+        // Touched page by page, so the pages are resident even where the allocation is lazy
+        const auto block = std::make_unique_for_overwrite<char[]>(kBytes);
+        for (size_t i = 0; i < kBytes; i += 4096) static_cast<volatile char*>(block.get())[i] = 1;
+    }
+    const auto stats = tracker.stop();
+    if (!aoc::MemoryTracker::available()) {
+        REQUIRE(stats.peakRssBytes == 0);
+        REQUIRE(aoc::residentBytes() == 0);
+        return;
+    }
+    REQUIRE(aoc::residentBytes() > 0);
+    // The block is freed again, but the peak stays
+    REQUIRE(stats.peakRssBytes >= kBytes / 2);
+    REQUIRE(stats.minorFaults >= kBytes / 4096 / 2);
+
+    tracker.start();
+    const auto idle = tracker.stop();
+    REQUIRE(idle.peakRssBytes < kBytes / 2);
+}
@@ -0,0 +1,46 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/perf_counters.hpp>
+#include <aoc/thread_pool.hpp>
+
+#include <cstddef>
+
+TEST_CASE("formatCounters skips missing events") {
+    aoc::PerfCounters::Values values;
+    REQUIRE(aoc::formatCounters(values).empty());
+    values[aoc::PerfCounters::kCycles] = 2e9;
+    values[aoc::PerfCounters::kInstructions] = 3e9;
+    values[aoc::PerfCounters::kBranchMisses] = 1500;
+    REQUIRE(aoc::formatCounters(values) == "cycles 2.00G, instr 3.00G, IPC 1.50, branch miss 1.50K");
+}
+
+TEST_CASE("PerfCounters count the calling thread when the kernel allows it") {
+    aoc::PerfCounters counters;
+    counters.start();
+    volatile int sink = 0;
+    for (int i = 0; i < 100'000; ++i) sink = sink + i;
+    const auto values = counters.stop();
+    if (!counters.available()) SUCCEED("perf_event_open not permitted here");
+    for (const auto& v : values)
+        if (v) REQUIRE(*v >= 0);
+}
+
+TEST_CASE("PerfCounters see the body of a parallelFor on a pool without workers") {
+    // What runDay uses with --counters, see BenchOptions::sharedPoolSize
+    aoc::ThreadPool pool{0};
+    auto body = [](size_t i) {
+        volatile size_t sink = 0;
+        for (size_t j = 0; j < 1000; ++j) sink = sink + i * j;
+    };
+    aoc::PerfCounters counters;
+    counters.start();
+    for (size_t i = 0; i < 1000; ++i) body(i);
+    const auto sequential = counters.stop()[aoc::PerfCounters::kInstructions];
+    counters.start();
+    pool.parallelFor(1000, body);
+    const auto parallel = counters.stop()[aoc::PerfCounters::kInstructions];
+    if (!sequential || !parallel) {
+        SUCCEED("perf_event_open not permitted here");
+        return;
+    }
+    REQUIRE(*parallel >= *sequential * 0.9);
+}
@@ -0,0 +1,33 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/prefetch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("Prefetcher reads every file, whichever backend it gets") {
+    std::vector<std::string> filenames;
+    std::vector<std::string> contents;
+    for (size_t size : {11, 0, 5'000'000}) {
+        filenames.push_back("test-aoc-prefetch-" + std::to_string(filenames.size()) + ".txt");
+        std::string content(size, 'x');
+        for (size_t i = 0; i < size; ++i) content[i] = static_cast<char>('a' + i % 23);
+        std::ofstream{filenames.back(), std::ios::binary} << content;
+        contents.push_back(std::move(content));
+    }
+    filenames.push_back("test-aoc-prefetch-missing.txt");
+
+    {
+        aoc::Prefetcher prefetcher{filenames};
+        REQUIRE((prefetcher.backend() == "io_uring" || prefetcher.backend() == "pread"));
+        REQUIRE(prefetcher.size() == 4);
+        // Out of order, and twice
+        REQUIRE(prefetcher.text(2) == contents[2]);
+        for (size_t i = 0; i < contents.size(); ++i) REQUIRE(prefetcher.text(i) == contents[i]);
+        REQUIRE_FALSE(prefetcher.text(3));
+    }
+    // Dropped before anything is asked for
+    { const aoc::Prefetcher prefetcher{filenames}; }
+    for (const auto& filename : filenames) std::remove(filename.c_str());
+}
@@ -0,0 +1,49 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/profiler.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace
+{
+
+// Kept out of line so that it shows up in the stacks
+[[gnu::noinline]] uint64_t spinFor(std::chrono::milliseconds duration) {
+    const auto endTime = std::chrono::steady_clock::now() + duration;
+    volatile uint64_t res{};
+    while (std::chrono::steady_clock::now() < endTime) res = res + 1;
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("Profiler writes folded stacks") {
+    REQUIRE_FALSE(aoc::Profiler{""});
+    const std::string filename = "test-aoc-profile.folded";
+    {
+        const aoc::Profiler profiler{filename};
+#ifdef __linux__
+        REQUIRE(profiler);
+#else
+        REQUIRE_FALSE(profiler);
+#endif
+        spinFor(std::chrono::milliseconds{300});
+    }
+#ifdef __linux__
+    std::ifstream in{filename};
+    size_t samples{};
+    bool sawSpin = false;
+    for (std::string line; std::getline(in, line);) {
+        const auto space = line.rfind(' ');
+        REQUIRE(space != std::string::npos);
+        samples += std::stoul(line.substr(space + 1));
+        sawSpin |= line.find("spinFor") != std::string::npos;
+    }
+    REQUIRE(samples > 0);
+    REQUIRE(sawSpin);
+#endif
+    std::remove(filename.c_str());
+}
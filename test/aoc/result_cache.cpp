@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/result_cache.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("ResultCache hits only for the same day and input") {
+    const std::string directory = "test-aoc-cache";
+    std::filesystem::remove_all(directory);
+    const aoc::ResultCache cache{directory, "day0", "12\n34\n"};
+    REQUIRE_FALSE(cache.load());
+
+    const aoc::ResultCache::Answers answers{"46", "408"};
+    REQUIRE(cache.store(answers));
+    REQUIRE(cache.load() == answers);
+    REQUIRE(aoc::ResultCache{directory, "day0", "12\n34\n"}.load() == answers);
+    REQUIRE_FALSE(aoc::ResultCache{directory, "day0", "12\n35\n"}.load());
+    REQUIRE_FALSE(aoc::ResultCache{directory, "day1", "12\n34\n"}.load());
+
+    const aoc::ResultCache::Answers part1Only{"47", std::nullopt};
+    REQUIRE(cache.store(part1Only));
+    REQUIRE(cache.load() == part1Only);
+    REQUIRE_FALSE(cache.store({"4\n7", std::nullopt}));
+    REQUIRE(cache.load() == part1Only);
+
+    // An entry of another input of the same size is a miss even under its key
+    const aoc::ResultCache other{directory, "day0", "12\n35\n"};
+    std::filesystem::copy_file(cache.path(), other.path());
+    REQUIRE_FALSE(other.load());
+
+    // An entry of another build is a miss
+    std::string entry{std::istreambuf_iterator<char>{std::ifstream{cache.path(), std::ios::binary}.rdbuf()}, {}};
+    entry.replace(0, entry.find('\n'), "build other");
+    std::ofstream{cache.path(), std::ios::binary} << entry;
+    REQUIRE_FALSE(cache.load());
+    std::filesystem::remove_all(directory);
+    REQUIRE_FALSE(aoc::buildId().empty());
+}
+
+TEST_CASE("ResultCache entries stored concurrently are whole") {
+    const std::string directory = "test-aoc-cache-concurrent";
+    std::filesystem::remove_all(directory);
+    const aoc::ResultCache cache{directory, "day0", "12\n34\n"};
+    std::atomic<int> failures{};
+    {
+        std::vector<std::jthread> writers;
+        for (int i = 0; i < 4; ++i) {
+            writers.emplace_back([&, i] {
+                const std::string answer(1000, static_cast<char>('a' + i));
+                for (int j = 0; j < 50; ++j) failures += !cache.store({answer, answer});
+            });
+        }
+    }
+    REQUIRE(failures == 0);
+    const auto answers = cache.load();
+    REQUIRE(answers);
+    REQUIRE(answers->part1.size() == 1000);
+    REQUIRE(std::ranges::count(answers->part1, answers->part1[0]) == 1000);
+    REQUIRE(answers->part2 == answers->part1);
+    // No temporary file left behind
+    REQUIRE(std::distance(std::filesystem::directory_iterator{directory}, {}) == 1);
+    std::filesystem::remove_all(directory);
+}
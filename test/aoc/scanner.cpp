@@ -0,0 +1,62 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/scanner.hpp>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+TEST_CASE("Scanner reads tokens and integers like a stream") {
+    aoc::Scanner in{"Game 12: -3 blue,\r\n 4 red"};
+    std::string_view word;
+    int id{};
+    char colon{};
+    REQUIRE(in >> word >> id >> colon);
+    REQUIRE(word == "Game");
+    REQUIRE(id == 12);
+    REQUIRE(colon == ':');
+    int64_t n{};
+    REQUIRE(in >> n >> word);
+    REQUIRE(n == -3);
+    REQUIRE(word == "blue,");
+    REQUIRE(in.rest() == "\r\n 4 red");
+    std::vector<int> numbers;
+    for (int v; in >> v;) numbers.push_back(v);
+    REQUIRE(numbers == std::vector<int>{4});
+    REQUIRE_FALSE(in);
+    REQUIRE(in.rest() == "red"); // the failed read only skipped whitespace
+    REQUIRE_FALSE(in >> word);
+}
+
+TEST_CASE("Scanner expect and end of text") {
+    aoc::Scanner in{"  seeds: 79 14"};
+    REQUIRE(in.expect("seeds:"));
+    int a{}, b{};
+    REQUIRE(in >> a >> b);
+    REQUIRE(a + b == 93);
+    std::string_view token;
+    REQUIRE_FALSE(in >> token);
+    REQUIRE_FALSE(aoc::Scanner{"x"}.expect("y"));
+}
+
+TEST_CASE("parseInt reads a leading integer") {
+    REQUIRE(aoc::parseInt("42,m=7") == 42);
+    REQUIRE(aoc::parseInt("-17") == -17);
+    REQUIRE(aoc::parseInt("x") == 0);
+    REQUIRE(aoc::parseInt<int64_t>("70c71", 16) == 461937);
+    REQUIRE(aoc::parseInt<int64_t>("1234567890123") == 1234567890123);
+}
+
+TEST_CASE("Scanner and parseInt work in constant expressions") {
+    STATIC_REQUIRE(aoc::parseInt("-17") == -17);
+    STATIC_REQUIRE(aoc::parseInt<int64_t>("70c71", 16) == 461937);
+    STATIC_REQUIRE([] {
+        aoc::Scanner in{"move 12 from 3"};
+        int n{}, from{};
+        return in.expect("move") && in >> n && in.expect("from") && in >> from && n * from == 36;
+    }());
+    // Overflow fails the read like std::from_chars does
+    STATIC_REQUIRE([] {
+        int8_t value{};
+        return !(aoc::Scanner{"300"} >> value);
+    }());
+}
@@ -0,0 +1,82 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("ThreadPool runs every task, including tasks submitted by tasks") {
+    std::atomic<int> count{};
+    {
+        aoc::ThreadPool pool{4};
+        REQUIRE(pool.size() == 4);
+        for (int i = 0; i < 100; ++i) {
+            pool.submit([&] {
+                ++count;
+                pool.submit([&] { ++count; });
+            });
+        }
+        pool.wait();
+        REQUIRE(count == 200);
+        pool.submit([&] { ++count; });
+    }
+    REQUIRE(count == 201); // the destructor finishes queued tasks
+}
+
+TEST_CASE("A pool without workers runs tasks and loops on the calling thread") {
+    aoc::ThreadPool pool{0};
+    REQUIRE(pool.size() == 0);
+    const auto caller = std::this_thread::get_id();
+    std::atomic<int> elsewhere{};
+    std::atomic<int> count{};
+    pool.submit([&] {
+        elsewhere += std::this_thread::get_id() != caller;
+        ++count;
+    });
+    REQUIRE(count == 1); // before wait()
+    pool.parallelFor(100, [&](size_t) {
+        elsewhere += std::this_thread::get_id() != caller;
+        ++count;
+    });
+    pool.wait();
+    REQUIRE(count == 101);
+    REQUIRE(elsewhere == 0);
+}
+
+TEST_CASE("parallelFor runs every index once, also nested in tasks") {
+    aoc::ThreadPool pool{3};
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallelFor(hits.size(), [&](size_t i) { ++hits[i]; });
+    REQUIRE(std::ranges::all_of(hits, [](const auto& n) { return n == 1; }));
+
+    std::atomic<int> count{};
+    for (int i = 0; i < 8; ++i)
+        pool.submit([&] { pool.parallelFor(100, [&](size_t) { pool.parallelFor(10, [&](size_t) { ++count; }); }); });
+    pool.wait();
+    REQUIRE(count == 8000);
+    pool.parallelFor(0, [](size_t) { FAIL(); });
+}
+
+TEST_CASE("parallelReduce combines in index order") {
+    aoc::ThreadPool pool{4};
+    const std::string letters = pool.parallelReduce(
+        26, std::string{">"}, [](size_t i) { return std::string(1, static_cast<char>('a' + i)); }, std::plus{});
+    REQUIRE(letters == ">abcdefghijklmnopqrstuvwxyz");
+    REQUIRE(pool.parallelReduce(0, 7, [](size_t) { return 1; }, std::plus{}) == 7);
+}
+
+TEST_CASE("PerWorker gives every thread of a loop its own slot") {
+    aoc::ThreadPool pool{4};
+    aoc::PerWorker<std::vector<size_t>> scratch{pool};
+    std::atomic<size_t> total{};
+    pool.parallelFor(10000, [&](size_t i) {
+        auto& mine = scratch.local();
+        mine.assign(3, i);
+        total += mine[0] + mine[1] + mine[2] == 3 * i;
+    });
+    REQUIRE(total == 10000);
+    REQUIRE(pool.workerIndex() == pool.size());
+}
@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/day.hpp>
+#include <aoc/trace.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+namespace
+{
+
+std::string readFile(const std::filesystem::path& path) {
+    std::ifstream file{path};
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+size_t countOf(std::string_view text, std::string_view pattern) {
+    size_t res{};
+    for (size_t pos = text.find(pattern); pos != text.npos; pos = text.find(pattern, pos + 1)) ++res;
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("TraceSession writes the spans of every thread") {
+    const std::filesystem::path filename = "test-aoc-trace.json";
+    { const aoc::TraceSpan before{"test", "before"}; }
+    {
+        const aoc::TraceSession trace{filename.string()};
+        REQUIRE(trace);
+        REQUIRE(aoc::TraceSession::active());
+        {
+            const aoc::TraceSpan outer{"test", "outer", "level", 1};
+            std::thread{[] { const aoc::TraceSpan inner{"test", "inner", "file", R"(a"b.txt)"}; }}.join();
+        }
+        const aoc::Day day = aoc::makeDay(
+            "day0", "day0.txt", {}, [](std::string_view text) { return text.size(); }, [](size_t n) { return n; });
+        REQUIRE(day.parse("abc").part1() == "3");
+    }
+    REQUIRE_FALSE(aoc::TraceSession::active());
+    { const aoc::TraceSpan after{"test", "after"}; }
+
+    const std::string json = readFile(filename);
+    REQUIRE(json.starts_with(R"({"displayTimeUnit": "ms", "traceEvents": [)"));
+    REQUIRE(json.ends_with("]}\n"));
+    REQUIRE(countOf(json, R"("ph": "X")") == 4);
+    REQUIRE(countOf(json, R"("name": "before")") == 0);
+    REQUIRE(countOf(json, R"("name": "after")") == 0);
+    REQUIRE(countOf(json, R"("name": "outer", "ts": )") == 1);
+    REQUIRE(countOf(json, R"("args": {"level": 1})") == 1);
+    REQUIRE(countOf(json, R"("args": {"file": "a\"b.txt"})") == 1);
+    REQUIRE(countOf(json, R"("cat": "day0", "name": "parseInput")") == 1);
+    REQUIRE(countOf(json, R"("cat": "day0", "name": "part1")") == 1);
+    // The other thread gets its own row
+    REQUIRE(countOf(json, R"("tid": )") == 4);
+    REQUIRE(json.find(R"("name": "inner")") != json.npos);
+    const size_t outerTid = json.rfind(R"("tid": )", json.find(R"("name": "outer")"));
+    const size_t innerTid = json.rfind(R"("tid": )", json.find(R"("name": "inner")"));
+    REQUIRE(json.substr(outerTid, 9) != json.substr(innerTid, 9));
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("TraceSession without a file records nothing") {
+    const aoc::TraceSession trace{""};
+    REQUIRE_FALSE(trace);
+    REQUIRE_FALSE(aoc::TraceSession::active());
+}
@@ -0,0 +1,35 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <aoc/day.hpp>
+#include <fmt/format.h>
+
+#include <string>
+
+// Built once per day with AOC_DAY set to the namespace of the day, see CMakeLists.txt
+namespace AOC_DAY
+{
+const aoc::Day& getDay();
+} // namespace AOC_DAY
+
+TEST_CASE("Samples") {
+    const aoc::Day& day = AOC_DAY::getDay();
+    for (size_t i = 0; i < day.samples.size(); ++i) {
+        const auto& sample = day.samples[i];
+        DYNAMIC_SECTION(day.name << " sample " << i + 1 << " part " << sample.part) {
+            CHECK(sample.parse(sample.input)() == sample.answer);
+        }
+    }
+}
+
+// Hidden, run with the [benchmark] tag
+TEST_CASE("Sample benchmarks", "[.][benchmark]") {
+    const aoc::Day& day = AOC_DAY::getDay();
+    for (size_t i = 0; i < day.samples.size(); ++i) {
+        const auto& sample = day.samples[i];
+        const std::string name = fmt::format("{} sample {}", day.name, i + 1);
+        // Parts are bound to their own parse, so the part is timed on an input parsed once up front
+        BENCHMARK(name + " parseInput") { return sample.parse(sample.input); };
+        const auto solve = sample.parse(sample.input);
+        BENCHMARK(fmt::format("{} part{}", name, sample.part)) { return solve(); };
+    }
+}